@@ -0,0 +1,128 @@
+/**
+ * @file    motor_ctrl_group_example.c
+ * @author  syhanjin
+ * @date    2026-10-17
+ * @brief   an example using the position controller group, with a cycle benchmark
+ *
+ * --------------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Project repository: https://github.com/HITSZ-WTR2026/motor_drivers
+ */
+
+#include "can.h"
+#include "controllers/motor_ctrl_group.h"
+#include "drivers/DJI.h"
+#include "interfaces/motor_if.h"
+
+#define GROUP_MOTOR_NUM (16U)
+
+/**
+ * 两路 CAN 各挂 8 个大疆电机
+ */
+DJI_t group_dji[GROUP_MOTOR_NUM];
+
+/**
+ * 对照组：每个电机一个独立的位置环控制实例
+ */
+Motor_PosCtrl_t group_pos_dji[GROUP_MOTOR_NUM];
+
+/**
+ * 位置环控制组
+ */
+Motor_PosCtrlGroup_t pos_group;
+
+/**
+ * 基准测试结果 (unit: cycle)，在调试器中查看
+ */
+uint32_t bench_individual_cycles;
+uint32_t bench_group_cycles;
+
+void MotorCtrlGroup_Example_Init()
+{
+    Motor_PosCtrlConfig_t members[GROUP_MOTOR_NUM];
+
+    for (size_t i = 0; i < GROUP_MOTOR_NUM; i++)
+    {
+        DJI_Init(&group_dji[i],
+                 &(DJI_Config_t) {
+                         .hcan       = i < 8 ? &hcan1 : &hcan2,
+                         .motor_type = M3508_C620,
+                         .id1        = i % 8 + 1,
+                 });
+
+        members[i] = (Motor_PosCtrlConfig_t) {
+                .motor_type = MOTOR_TYPE_DJI,
+                .motor      = &group_dji[i],
+                .velocity_pid =
+                        (MotorPID_Config_t) {
+                                .Kp             = 12.0f,
+                                .Ki             = 0.20f,
+                                .Kd             = 5.00f,
+                                .abs_output_max = 8000.0f,
+                        },
+                .position_pid =
+                        (MotorPID_Config_t) {
+                                .Kp             = 80.0f,
+                                .Ki             = 1.00f,
+                                .Kd             = 0.00f,
+                                .abs_output_max = 2000.0f,
+                        },
+                .pos_vel_freq_ratio = 1,
+                .error_threshold    = 1.0f,
+        };
+        Motor_PosCtrl_Init(&group_pos_dji[i], &members[i]);
+    }
+
+    /**
+     * 控制组与独立控制实例使用相同的配置
+     *
+     * 注意：和独立控制实例一样，同一个电机同一时刻只能被一个控制对象控制
+     */
+    Motor_PosCtrlGroup_Init(&pos_group,
+                            &(Motor_PosCtrlGroupConfig_t) {
+                                    .members            = members,
+                                    .count              = GROUP_MOTOR_NUM,
+                                    .pos_vel_freq_ratio = 1,
+                            });
+}
+
+/**
+ * 对比 N 次独立更新与一次组更新的耗时
+ *
+ * 使用 DWT->CYCCNT 计数，调用前应关闭控制定时器，避免两者同时驱动电机
+ */
+void MotorCtrlGroup_Benchmark()
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    for (size_t i = 0; i < GROUP_MOTOR_NUM; i++)
+        __MOTOR_CTRL_ENABLE(&group_pos_dji[i]);
+    __MOTOR_CTRL_ENABLE(&pos_group);
+
+    uint32_t start = DWT->CYCCNT;
+    for (size_t i = 0; i < GROUP_MOTOR_NUM; i++)
+        Motor_PosCtrlUpdate(&group_pos_dji[i]);
+    bench_individual_cycles = DWT->CYCCNT - start;
+
+    start = DWT->CYCCNT;
+    Motor_PosCtrlGroupUpdate(&pos_group);
+    bench_group_cycles = DWT->CYCCNT - start;
+
+    for (size_t i = 0; i < GROUP_MOTOR_NUM; i++)
+        __MOTOR_CTRL_DISABLE(&group_pos_dji[i]);
+    __MOTOR_CTRL_DISABLE(&pos_group);
+}
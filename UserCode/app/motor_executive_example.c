@@ -0,0 +1,114 @@
+/**
+ * @file    motor_executive_example.c
+ * @author  syhanjin
+ * @date    2026-10-17
+ * @brief   an example driving DJI motors through the control executive and scheduler
+ *
+ * --------------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Project repository: https://github.com/HITSZ-WTR2026/motor_drivers
+ */
+
+#include "can.h"
+#include "controllers/motor_executive.h"
+#include "controllers/motor_scheduler.h"
+#include "drivers/DJI.h"
+#include "interfaces/motor_if.h"
+#include "tim.h"
+
+#define EXEC_MOTOR_NUM (4U)
+
+DJI_t           exec_dji[EXEC_MOTOR_NUM];
+Motor_PosCtrl_t exec_pos[EXEC_MOTOR_NUM];
+
+/**
+ * 控制定时器 htim6 频率为 2 kHz
+ */
+MotorExec_t        exec;
+MotorExec_Item_t   exec_items[8];
+MotorSched_t       exec_sched;
+MotorSched_Entry_t exec_sched_entries[EXEC_MOTOR_NUM];
+
+static void sched_task(void* context)
+{
+    MotorSched_Tick(context);
+}
+
+static void dji_flush_task(void* context)
+{
+    DJI_SendSetIqCommand(context, IQ_CMD_GROUP_1_4);
+}
+
+void MotorExec_Example_Init()
+{
+    // CAN 与电机初始化参考 dji_example.c
+    for (size_t i = 0; i < EXEC_MOTOR_NUM; i++)
+    {
+        DJI_Init(&exec_dji[i],
+                 &(DJI_Config_t) {
+                         .hcan       = &hcan1,
+                         .motor_type = M3508_C620,
+                         .id1        = i + 1,
+                 });
+        Motor_PosCtrl_Init(&exec_pos[i],
+                           &(Motor_PosCtrlConfig_t) {
+                                   .motor_type = MOTOR_TYPE_DJI,
+                                   .motor      = &exec_dji[i],
+                                   .velocity_pid =
+                                           (MotorPID_Config_t) {
+                                                   .Kp             = 12.0f,
+                                                   .Ki             = 0.20f,
+                                                   .Kd             = 5.00f,
+                                                   .abs_output_max = 8000.0f,
+                                           },
+                                   .position_pid =
+                                           (MotorPID_Config_t) {
+                                                   .Kp             = 80.0f,
+                                                   .Ki             = 1.00f,
+                                                   .Kd             = 0.00f,
+                                                   .abs_output_max = 2000.0f,
+                                           },
+                           });
+        __MOTOR_CTRL_ENABLE(&exec_pos[i]);
+    }
+
+    /**
+     * 调度器：速度环 1 kHz，位置环 500 Hz，各电机错开到不同节拍
+     */
+    MotorSched_Init(&exec_sched,
+                    &(MotorSched_Config_t) {
+                            .base_freq = 2000,
+                            .entries   = exec_sched_entries,
+                            .capacity  = EXEC_MOTOR_NUM,
+                    });
+    for (size_t i = 0; i < EXEC_MOTOR_NUM; i++)
+        MotorSched_AddPosCtrl(&exec_sched, &exec_pos[i], 500, 1000);
+
+    /**
+     * 执行器：控制阶段运行调度器，发送阶段统一发送电流指令
+     *
+     * stats 中记录了每个阶段的耗时，可在调试器中查看
+     */
+    MotorExec_Init(&exec,
+                   &(MotorExec_Config_t) {
+                           .htim        = &htim6,
+                           .items       = exec_items,
+                           .capacity    = 8,
+                           .deadline_us = 400, // 周期 500 us，留出余量给其他中断
+                   });
+    MotorExec_Register(&exec, MOTOR_EXEC_PHASE_CONTROL, sched_task, &exec_sched);
+    MotorExec_Register(&exec, MOTOR_EXEC_PHASE_FLUSH, dji_flush_task, &hcan1);
+    MotorExec_Start(&exec);
+}
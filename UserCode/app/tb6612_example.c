@@ -52,6 +52,9 @@ void TB_TIM_Callback(TIM_HandleTypeDef* htim)
     /**
      * 对于 TB6612 电机，PID 计算的过程中已经完成了 PWM 占空比设置
      * 故无须单独调用发送函数
+     *
+     * 多个电机需要同时改变占空比时，可以使用同步更新组 (TB6612_Group_t)，
+     * 将控制更新放在 TB6612_Group_Begin 和 TB6612_Group_Commit 之间
      */
     Motor_PosCtrlUpdate(&pos_ctrl);
     Motor_VelCtrlUpdate(&vel_ctrl);
@@ -76,6 +79,14 @@ void TB6612_Control_Init()
                         .roto_radio      = 4 * 13, //< 4 * 线数，4 倍是因为开启了双边沿计数
                         .reduction_radio = 30,     //< 减速比
                         .sampling_period = 0.001f, //< 采样间隔 (unit: s)
+                        .stop_mode       = TB6612_STOP_BRAKE, //< 输出为零时短路制动
+                        .deadband        = 0.002f, //< 占空比小于该值时停止，避免零点附近抖动
+                        .friction_duty   = 0.05f,  //< 静摩擦补偿占空比，需根据实际电机标定
+                        .velocity_filter =
+                                {
+                                        .type  = TB6612_VEL_FILTER_IIR, //< 一阶低通滤波转速
+                                        .alpha = 0.3f,                  //< 越小越平滑，相位滞后越大
+                                },
                 });
     TB6612_Enable(&tb6612);
 
@@ -119,6 +119,10 @@ void VESC_Control_Init()
                        &(Motor_VelCtrlConfig_t) {
                                .motor_type = MOTOR_TYPE_VESC,
                                .motor      = &vesc,
+                               // 转速变化不超过 1 rpm 时不重复发送，每 50 ms 保活一次
+                               // 保活间隔需小于 VESC Tool 中设置的指令超时时间
+                               .tx_deadband     = 1.0f,
+                               .tx_keepalive_ms = 50,
                        });
     Motor_PosCtrl_Init(&vesc_pos_ctrl,
                        &(Motor_PosCtrlConfig_t) { .motor_type   = MOTOR_TYPE_VESC,
@@ -44,6 +44,8 @@ typedef struct
     CAN_HandleTypeDef*        hcan;
     CAN_FifoReceiveCallback_t callbacks[CAN_MAX_CALLBACK_NUM];
     uint32_t                  callback_count;
+    PROFILE_FIELD(tx_profile) ///< CAN_SendMessage 耗时 (含等待邮箱)
+    PROFILE_FIELD(rx_profile) ///< 接收中断回调耗时 (含各驱动解码)
 } CAN_CallbackMap;
 
 static CAN_CallbackMap maps[CAN_NUM];
@@ -58,18 +60,27 @@ static CAN_CallbackMap* get_map(const CAN_HandleTypeDef* hcan)
     return NULL;
 }
 
-/**
- * 发送一条 CAN 消息
- * @param hcan can handle
- * @param header CAN_TxHeaderTypeDef
- * @param data 数据
- * @note 本身想做成内联展开，但是必须写到 .h 文件，调研发现性能损失不大，所以直接放到此处
- * @attention 本函数大部分情况是线程安全的，少数情况（中断被中断打断）会出现不安全的情况。
- * @return mailbox, 0xFFFF 表示发送失败
- */
-uint32_t CAN_SendMessage(CAN_HandleTypeDef*         hcan,
-                         const CAN_TxHeaderTypeDef* header,
-                         const uint8_t              data[])
+static CAN_CallbackMap* get_or_add_map(CAN_HandleTypeDef* hcan)
+{
+    CAN_CallbackMap* map = get_map(hcan);
+
+    if (map == NULL)
+    {
+        if (map_size >= CAN_NUM)
+        {
+            CAN_ERROR_HANDLER();
+            return NULL;
+        }
+        maps[map_size] = (CAN_CallbackMap) { .hcan = hcan };
+        map            = &maps[map_size];
+        map_size++;
+    }
+    return map;
+}
+
+static uint32_t can_send_message(CAN_HandleTypeDef*         hcan,
+                                 const CAN_TxHeaderTypeDef* header,
+                                 const uint8_t              data[])
 {
     uint32_t mailbox = CAN_SEND_FAILED;
 
@@ -111,6 +122,29 @@ uint32_t CAN_SendMessage(CAN_HandleTypeDef*         hcan,
     return mailbox;
 }
 
+/**
+ * 发送一条 CAN 消息
+ * @param hcan can handle
+ * @param header CAN_TxHeaderTypeDef
+ * @param data 数据
+ * @note 本身想做成内联展开，但是必须写到 .h 文件，调研发现性能损失不大，所以直接放到此处
+ * @attention 本函数大部分情况是线程安全的，少数情况（中断被中断打断）会出现不安全的情况。
+ * @return mailbox, 0xFFFF 表示发送失败
+ */
+uint32_t CAN_SendMessage(CAN_HandleTypeDef*         hcan,
+                         const CAN_TxHeaderTypeDef* header,
+                         const uint8_t              data[])
+{
+    PROFILE_BEGIN();
+    const uint32_t mailbox = can_send_message(hcan, header, data);
+#ifdef MOTOR_IF_PROFILE
+    CAN_CallbackMap* map = get_map(hcan);
+    if (map != NULL)
+        PROFILE_END(&map->tx_profile);
+#endif
+    return mailbox;
+}
+
 /**
  * CAN 初始化
  * @param hcan can handle
@@ -118,6 +152,9 @@ uint32_t CAN_SendMessage(CAN_HandleTypeDef*         hcan,
  */
 void CAN_Start(CAN_HandleTypeDef* hcan, const uint32_t ActiveITs)
 {
+    // 提前登记，只发送不接收的总线也有对应的耗时统计
+    get_or_add_map(hcan);
+
     if (HAL_CAN_Start(hcan) != HAL_OK)
     {
         CAN_ERROR_HANDLER();
@@ -138,20 +175,10 @@ void CAN_Start(CAN_HandleTypeDef* hcan, const uint32_t ActiveITs)
  */
 void CAN_RegisterCallback(CAN_HandleTypeDef* hcan, const CAN_FifoReceiveCallback_t callback)
 {
-    CAN_CallbackMap* map = get_map(hcan);
+    CAN_CallbackMap* map = get_or_add_map(hcan);
 
     if (map == NULL)
-    {
-        if (map_size >= CAN_NUM)
-        {
-            CAN_ERROR_HANDLER();
-            return;
-        }
-        maps[map_size] =
-                (CAN_CallbackMap) { .hcan = hcan, .callbacks = { NULL }, .callback_count = 0 };
-        map = &maps[map_size];
-        map_size++;
-    }
+        return;
     if (map->callback_count < CAN_MAX_CALLBACK_NUM)
         map->callbacks[map->callback_count++] = callback;
     else
@@ -181,15 +208,18 @@ void CAN_Fifo0ReceiveCallback(CAN_HandleTypeDef* hcan)
 {
     CAN_RxHeaderTypeDef header;
     uint8_t             data[8];
+    PROFILE_BEGIN();
     if (HAL_CAN_GetRxMessage(hcan, CAN_RX_FIFO0, &header, data) != HAL_OK)
     {
         CAN_ERROR_HANDLER();
         return;
     }
-    const CAN_CallbackMap* map = get_map(hcan);
-    if (map != NULL)
-        for (size_t i = 0; i < map->callback_count; i++)
-            map->callbacks[i](hcan, &header, data);
+    CAN_CallbackMap* map = get_map(hcan);
+    if (map == NULL)
+        return;
+    for (size_t i = 0; i < map->callback_count; i++)
+        map->callbacks[i](hcan, &header, data);
+    PROFILE_END(&map->rx_profile);
 }
 /**
  * CAN Fifo1 接收处理函数
@@ -201,17 +231,44 @@ void CAN_Fifo1ReceiveCallback(CAN_HandleTypeDef* hcan)
 {
     CAN_RxHeaderTypeDef header;
     uint8_t             data[8];
+    PROFILE_BEGIN();
     if (HAL_CAN_GetRxMessage(hcan, CAN_RX_FIFO1, &header, data) != HAL_OK)
     {
         CAN_ERROR_HANDLER();
         return;
     }
-    const CAN_CallbackMap* map = get_map(hcan);
-    if (map != NULL)
-        for (size_t i = 0; i < map->callback_count; i++)
-            map->callbacks[i](hcan, &header, data);
+    CAN_CallbackMap* map = get_map(hcan);
+    if (map == NULL)
+        return;
+    for (size_t i = 0; i < map->callback_count; i++)
+        map->callbacks[i](hcan, &header, data);
+    PROFILE_END(&map->rx_profile);
 }
 
+#ifdef MOTOR_IF_PROFILE
+/**
+ * 获取 CAN 发送耗时统计
+ * @param hcan can handle
+ * @return 耗时统计，hcan 未启动或未注册回调时返回 NULL
+ */
+Profile_t* CAN_GetTxProfile(const CAN_HandleTypeDef* hcan)
+{
+    CAN_CallbackMap* map = get_map(hcan);
+    return map != NULL ? &map->tx_profile : NULL;
+}
+
+/**
+ * 获取 CAN 接收耗时统计
+ * @param hcan can handle
+ * @return 耗时统计，hcan 未启动或未注册回调时返回 NULL
+ */
+Profile_t* CAN_GetRxProfile(const CAN_HandleTypeDef* hcan)
+{
+    CAN_CallbackMap* map = get_map(hcan);
+    return map != NULL ? &map->rx_profile : NULL;
+}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -26,6 +26,7 @@
 #define CAN_H
 
 #include "main.h"
+#include "cycle_profiler.h"
 
 #define CAN_ERROR_HANDLER()  Error_Handler()
 #define CAN_SEND_FAILED      (0xFFFF)
@@ -55,6 +56,11 @@ void CAN_RegisterCallback(CAN_HandleTypeDef* hcan, CAN_FifoReceiveCallback_t cal
 void CAN_Fifo0ReceiveCallback(CAN_HandleTypeDef* hcan);
 void CAN_Fifo1ReceiveCallback(CAN_HandleTypeDef* hcan);
 
+#ifdef MOTOR_IF_PROFILE
+Profile_t* CAN_GetTxProfile(const CAN_HandleTypeDef* hcan);
+Profile_t* CAN_GetRxProfile(const CAN_HandleTypeDef* hcan);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
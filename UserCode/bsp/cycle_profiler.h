@@ -0,0 +1,187 @@
+/**
+ * @file    cycle_profiler.h
+ * @author  syhanjin
+ * @date    2026-10-17
+ * @brief   DWT CYCCNT based execution time profiler.
+ *
+ * 定义 MOTOR_IF_PROFILE 后，各控制对象的更新、驱动的反馈解码以及 CAN 收发会使用 DWT->CYCCNT 计时，
+ * 每个对象记录最小 / 平均 / 最大耗时和一个以 2 的幂为桶的直方图 (用于估计 p99)。
+ * 未定义时所有 PROFILE_* 宏为空，对象中也不包含统计字段。
+ *
+ * --------------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Project repository: https://github.com/HITSZ-WTR2026/motor_drivers
+ */
+#ifndef CYCLE_PROFILER_H
+#define CYCLE_PROFILER_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "main.h"
+
+/**
+ * 启用 DWT 周期计数器，在使用前调用一次
+ *
+ * 不依赖 MOTOR_IF_PROFILE，需要 DWT->CYCCNT 计时的模块 (如控制执行器) 也使用该函数
+ */
+static inline void Profile_Enable(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+// 需要统计耗时请启用以下宏
+// #define MOTOR_IF_PROFILE
+
+#ifdef MOTOR_IF_PROFILE
+
+#    include <string.h>
+
+/**
+ * 直方图桶数，第 i 个桶统计耗时在 [2^(i-1), 2^i) 的样本，第 0 个桶统计耗时为 0 的样本
+ */
+#    define PROFILE_BUCKET_NUM (33U)
+
+/**
+ * 耗时统计
+ */
+typedef struct
+{
+    uint32_t count;                    ///< 样本数
+    uint32_t min;                      ///< 最小耗时 (unit: cycle)
+    uint32_t max;                      ///< 最大耗时 (unit: cycle)
+    uint64_t sum;                      ///< 耗时总和 (unit: cycle)
+    uint32_t hist[PROFILE_BUCKET_NUM]; ///< 直方图
+} Profile_t;
+
+/**
+ * 耗时统计快照
+ */
+typedef struct
+{
+    uint32_t count; ///< 样本数
+    uint32_t min;   ///< 最小耗时 (unit: cycle)
+    uint32_t mean;  ///< 平均耗时 (unit: cycle)
+    uint32_t max;   ///< 最大耗时 (unit: cycle)
+    uint32_t p99;   ///< 99 分位耗时上界 (unit: cycle)，精度为一个 2 的幂桶
+} Profile_Snapshot_t;
+
+/**
+ * 清空统计，可在运行中调用
+ * @param profile 统计对象
+ */
+static inline void Profile_Reset(Profile_t* profile)
+{
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    memset(profile, 0, sizeof(Profile_t));
+    __set_PRIMASK(primask);
+}
+
+/**
+ * 记录一次耗时
+ *
+ * 同一统计对象可能同时在任务和中断中记录 (如 CAN 发送)，或被不同优先级的中断共用
+ * (如两个接收 FIFO)，更新在关中断状态下进行，避免嵌套时样本丢失或字段不一致
+ * @param profile 统计对象
+ * @param cycles 耗时 (unit: cycle)
+ */
+static inline void Profile_Record(Profile_t* profile, const uint32_t cycles)
+{
+    const uint32_t bucket  = cycles == 0 ? 0 : 32 - __builtin_clz(cycles);
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (profile->count == 0 || cycles < profile->min)
+        profile->min = cycles;
+    if (cycles > profile->max)
+        profile->max = cycles;
+    profile->sum += cycles;
+    profile->count++;
+    profile->hist[bucket]++;
+    __set_PRIMASK(primask);
+}
+
+/**
+ * 获取统计快照
+ *
+ * 统计会在中断中更新，快照在关中断状态下复制，保证各字段一致
+ * @param profile 统计对象
+ * @param snapshot 快照
+ */
+static inline void Profile_GetSnapshot(const Profile_t* profile, Profile_Snapshot_t* snapshot)
+{
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    const Profile_t copy = *profile;
+    __set_PRIMASK(primask);
+
+    snapshot->count = copy.count;
+    snapshot->min   = copy.count ? copy.min : 0;
+    snapshot->max   = copy.max;
+    snapshot->mean  = copy.count ? (uint32_t) (copy.sum / copy.count) : 0;
+    snapshot->p99   = 0;
+
+    // 从小到大累计到 99% 的样本所在的桶，取桶上界
+    const uint32_t target = copy.count - copy.count / 100;
+    uint32_t       acc    = 0;
+    for (uint32_t i = 0; i < PROFILE_BUCKET_NUM && copy.count != 0; i++)
+    {
+        acc += copy.hist[i];
+        if (acc >= target)
+        {
+            const uint32_t upper = i == 0 ? 0 : (i == 32 ? UINT32_MAX : (1U << i) - 1);
+            snapshot->p99        = upper < copy.max ? upper : copy.max;
+            break;
+        }
+    }
+}
+
+/**
+ * 在对象中声明统计字段
+ */
+#    define PROFILE_FIELD(__NAME__) Profile_t __NAME__;
+
+/**
+ * 清空统计，用于对象初始化
+ */
+#    define PROFILE_RESET(__PROFILE__) Profile_Reset(__PROFILE__)
+
+/**
+ * 开始计时，同一作用域内只能使用一次
+ */
+#    define PROFILE_BEGIN() const uint32_t __profile_start = DWT->CYCCNT
+
+/**
+ * 结束计时并记录
+ */
+#    define PROFILE_END(__PROFILE__) Profile_Record((__PROFILE__), DWT->CYCCNT - __profile_start)
+
+#else
+
+#    define PROFILE_FIELD(__NAME__)
+#    define PROFILE_RESET(__PROFILE__)
+#    define PROFILE_BEGIN()
+#    define PROFILE_END(__PROFILE__)
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CYCLE_PROFILER_H
@@ -0,0 +1,20 @@
+/**
+ * @file    motor_pos.c
+ * @author  syhanjin
+ * @date    2026-10-17
+ */
+
+#include "motor_pos.h"
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * 定点位置写入计数，见 MotorPos_Load
+ */
+volatile uint32_t motor_pos_write_seq = 0;
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,306 @@
+/**
+ * @file    motor_pos.h
+ * @author  syhanjin
+ * @date    2026-10-17
+ * @brief   64-bit fixed-point motor position (integer turns + Q32 fraction).
+ *
+ * 用 float 表示累计角度时，分辨率随转过的距离变差 (约 1e6 deg 以上时超过 0.1 deg)，
+ * 长时间连续旋转的机构 (如绞盘) 的位置环会逐渐变差。
+ * MotorPos_t 的高 32 位为整圈数，低 32 位为圈内小数 (Q32)，分辨率恒为 360 / 2^32 deg，
+ * 两个位置先在定点下相减再转为 float，误差的精度与转过的距离无关。
+ *
+ * --------------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Project repository: https://github.com/HITSZ-WTR2026/motor_drivers
+ */
+#ifndef MOTOR_POS_H
+#define MOTOR_POS_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include "main.h"
+
+/**
+ * 定点位置 (unit: 圈，Q32)
+ */
+typedef int64_t MotorPos_t;
+
+/**
+ * 一圈
+ */
+#define MOTOR_POS_ONE_TURN ((MotorPos_t) 1 << 32)
+
+/**
+ * 一度对应的定点值
+ */
+#define MOTOR_POS_PER_DEG (4294967296.0f / 360.0f)
+
+/**
+ * 一个定点单位对应的角度
+ */
+#define MOTOR_POS_DEG_PER_LSB (360.0f / 4294967296.0f)
+
+/**
+ * 定点位置写入计数，每次 MotorPos_Store 加一
+ */
+extern volatile uint32_t motor_pos_write_seq;
+
+/**
+ * 读取定点位置
+ *
+ * Cortex-M4 没有 64 位的单次原子访存：LDRD / STRD 拆成两次 32 位访问，
+ * 两次访问之间可以响应中断 (指令在中断返回后重新执行)，也没有 LDREXD / STREXD。
+ * 反馈解码中断、控制中断和任务之间相互抢占时，可能读到只写了一半的值，在整圈边界处会相差一整圈。
+ *
+ * 写入在关中断状态下完成并递增全局写入计数，读者不会打断写入；
+ * 读取不关中断，读取前后的写入计数不同说明期间有写入抢占，重新读取
+ * @param src 定点位置
+ * @return 定点位置
+ */
+static inline MotorPos_t MotorPos_Load(const volatile MotorPos_t* src)
+{
+    uint32_t   seq;
+    MotorPos_t value;
+    do
+    {
+        seq   = motor_pos_write_seq;
+        value = *src;
+    } while (seq != motor_pos_write_seq);
+    return value;
+}
+
+/**
+ * 写入定点位置，见 MotorPos_Load
+ * @note 只有写入需要短暂关中断，写入频率为各电机的反馈频率，远低于读取频率
+ * @param dst 定点位置
+ * @param value 新的值
+ */
+static inline void MotorPos_Store(volatile MotorPos_t* dst, const MotorPos_t value)
+{
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *dst = value;
+    motor_pos_write_seq++;
+    __set_PRIMASK(primask);
+}
+
+/**
+ * 角度转为定点位置
+ *
+ * 整圈和圈内部分分开转换，结果的精度受限于输入 float 本身的精度
+ * @param deg 角度 (unit: deg)
+ * @return 定点位置
+ */
+static inline MotorPos_t MotorPos_FromDeg(const float deg)
+{
+    const int32_t turns = (int32_t) (deg / 360.0f);
+    const float   rem   = deg - (float) turns * 360.0f;
+    return (MotorPos_t) turns * MOTOR_POS_ONE_TURN + (MotorPos_t) (rem * MOTOR_POS_PER_DEG);
+}
+
+/**
+ * 定点位置转为角度，用于显示或与 float 接口交互，大角度时会损失精度
+ * @param pos 定点位置
+ * @return 角度 (unit: deg)
+ */
+static inline float MotorPos_ToDeg(const MotorPos_t pos)
+{
+    const int32_t turns = (int32_t) (pos >> 32);
+    const float   frac  = (float) (uint32_t) pos * MOTOR_POS_DEG_PER_LSB;
+    return (float) turns * 360.0f + frac;
+}
+
+/**
+ * 计算两个位置之差，先在定点下相减再转为角度
+ * @param a 被减数
+ * @param b 减数
+ * @return a - b (unit: deg)
+ */
+static inline float MotorPos_DiffDeg(const MotorPos_t a, const MotorPos_t b)
+{
+    return (float) (a - b) * MOTOR_POS_DEG_PER_LSB;
+}
+
+/**
+ * 在位置上叠加一个角度
+ * @param pos 定点位置
+ * @param deg 角度 (unit: deg)
+ * @return 定点位置
+ */
+static inline MotorPos_t MotorPos_AddDeg(const MotorPos_t pos, const float deg)
+{
+    return pos + MotorPos_FromDeg(deg);
+}
+
+/**
+ * 由浮点数近似传动比时分子分母的上限
+ */
+#ifndef MOTOR_POS_RATIO_TERM_MAX
+#    define MOTOR_POS_RATIO_TERM_MAX (100000U)
+#endif
+
+/**
+ * 传动比 (减速比) num / den，即输入圈数 (或计数) / 输出圈数
+ *
+ * 以整数分子分母保存，整圈部分的换算没有舍入误差，位置精度不随转过的距离变差
+ */
+typedef struct
+{
+    uint32_t num;   ///< 分子，不超过 INT32_MAX
+    uint32_t den;   ///< 分母，不超过 INT32_MAX
+    float    scale; ///< den / num，用于圈内部分的浮点换算
+} MotorPos_Ratio_t;
+
+static inline uint32_t motor_pos_gcd(uint32_t a, uint32_t b)
+{
+    while (b != 0)
+    {
+        const uint32_t t = a % b;
+        a                = b;
+        b                = t;
+    }
+    return a;
+}
+
+/**
+ * 构造传动比，分子分母会约分，超过 INT32_MAX 时按比例缩小 (此时不再精确)
+ * @param num 分子
+ * @param den 分母
+ * @return 传动比
+ */
+static inline MotorPos_Ratio_t MotorPos_Ratio(uint64_t num, uint64_t den)
+{
+    if (num == 0 || den == 0)
+        num = den = 1;
+    while (num > INT32_MAX || den > INT32_MAX)
+    {
+        num = (num + 1) / 2;
+        den = (den + 1) / 2;
+    }
+    const uint32_t   g = motor_pos_gcd((uint32_t) num, (uint32_t) den);
+    MotorPos_Ratio_t r = {
+        .num = (uint32_t) num / g,
+        .den = (uint32_t) den / g,
+    };
+    r.scale = (float) r.den / (float) r.num;
+    return r;
+}
+
+/**
+ * 由浮点数得到传动比，用于配置中以 float 给出的外接减速比
+ *
+ * 先尝试以不超过 5 位的小数还原 (如 19.203)，否则以连分数求分子分母均不超过
+ * MOTOR_POS_RATIO_TERM_MAX 的最佳近似 (如 1 / 3)，二者误差均在 float 的一个 ulp 内
+ * @param ratio 传动比，不大于 0 时视为 1
+ * @return 传动比
+ */
+static inline MotorPos_Ratio_t MotorPos_RatioFromFloat(const float ratio)
+{
+    if (ratio <= 0)
+        return MotorPos_Ratio(1, 1);
+
+    const double tol = (double) ratio * 1.2e-7; // float 的一个 ulp (2^-23)
+
+    for (uint64_t scale = 1; scale <= MOTOR_POS_RATIO_TERM_MAX; scale *= 10)
+    {
+        const uint64_t n   = (uint64_t) ((double) ratio * (double) scale + 0.5);
+        const double   err = (double) n / (double) scale - (double) ratio;
+        if (n == 0 || n > MOTOR_POS_RATIO_TERM_MAX)
+            continue;
+        if (err < tol && err > -tol)
+            return MotorPos_Ratio(n, scale);
+    }
+
+    // h / k 为当前渐近分数，h1 / k1 为上一个
+    uint64_t h = 1, k = 0, h1 = 0, k1 = 1;
+    double   x = ratio;
+    for (int i = 0; i < 32; i++)
+    {
+        const uint64_t a  = (uint64_t) x;
+        const uint64_t h2 = a * h + h1;
+        const uint64_t k2 = a * k + k1;
+        if (h2 > MOTOR_POS_RATIO_TERM_MAX || k2 > MOTOR_POS_RATIO_TERM_MAX)
+            break;
+        h1 = h;
+        k1 = k;
+        h  = h2;
+        k  = k2;
+        const double err = (double) h / (double) k - (double) ratio;
+        if (err < tol && err > -tol)
+            break;
+        x = 1.0 / (x - (double) a);
+    }
+    if (k == 0) // 超出可表示的范围
+        return MotorPos_Ratio(MOTOR_POS_RATIO_TERM_MAX, 1);
+    if (h == 0)
+        return MotorPos_Ratio(1, MOTOR_POS_RATIO_TERM_MAX);
+    return MotorPos_Ratio(h, k);
+}
+
+/**
+ * 两级传动比相乘
+ */
+static inline MotorPos_Ratio_t MotorPos_RatioMul(const MotorPos_Ratio_t a, const MotorPos_Ratio_t b)
+{
+    return MotorPos_Ratio((uint64_t) a.num * b.num, (uint64_t) a.den * b.den);
+}
+
+/**
+ * 由输入侧的整数计数 (转子圈数或编码器计数) 计算输出轴位置
+ *
+ * 整圈与圈内小数均由整数除法得到，误差不超过 1 LSB，与计数大小无关
+ * @param count 输入侧计数
+ * @param ratio 每个输出圈对应的计数
+ * @return 输出轴定点位置
+ */
+static inline MotorPos_t MotorPos_FromCount(const int64_t count, const MotorPos_Ratio_t ratio)
+{
+    const int64_t total = count * (int64_t) ratio.den;
+    int64_t       whole = total / ratio.num;
+    int64_t       rem   = total % ratio.num;
+    if (rem < 0)
+    { // 向下取整，保证小数部分非负
+        rem += ratio.num;
+        whole--;
+    }
+    return whole * MOTOR_POS_ONE_TURN + (MotorPos_t) (((uint64_t) rem << 32) / ratio.num);
+}
+
+/**
+ * 由转子圈数和圈内角度计算输出轴位置
+ *
+ * 整圈部分由 MotorPos_FromCount 精确计算；圈内部分不足一圈，用 float 计算即可
+ * @param round_cnt 转子圈数
+ * @param deg 圈内角度，可以为负 (unit: deg)
+ * @param ratio 减速比
+ * @return 输出轴定点位置
+ */
+static inline MotorPos_t MotorPos_FromRotor(const int32_t          round_cnt,
+                                            const float            deg,
+                                            const MotorPos_Ratio_t ratio)
+{
+    return MotorPos_FromCount(round_cnt, ratio) +
+           (MotorPos_t) (deg * ratio.scale * MOTOR_POS_PER_DEG);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MOTOR_POS_H
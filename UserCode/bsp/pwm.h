@@ -30,14 +30,49 @@ extern "C"
 {
 #endif
 
+/**
+ * PWM 通道
+ *
+ * arr 和 ccr 由 PWM_Init (PWM_Start 会调用) 填写；
+ * 零初始化的对象 (如 { &htim, TIM_CHANNEL_x }) 在第一次设置占空比时会自动补做 PWM_Init，
+ * 未初始化的栈上对象无法识别，必须先调用 PWM_Init 或 PWM_Start
+ */
 typedef struct
 {
     TIM_HandleTypeDef* htim;
     uint32_t           channel;
+
+    uint32_t           arr; ///< 缓存的自动重装载值，由 PWM_Init 读取
+    volatile uint32_t* ccr; ///< 通道对应的 CCR 寄存器，由 PWM_Init 计算
 } PWM_t;
 
+/**
+ * 缓存 ARR 和 CCR 寄存器地址
+ * @note 修改定时器的 ARR 后需要重新调用
+ * @param hpwm pwm handle (htim 和 channel 需已设置)
+ */
+static inline void PWM_Init(PWM_t* hpwm)
+{
+    hpwm->arr = __HAL_TIM_GET_AUTORELOAD(hpwm->htim);
+    // CCR1 ~ CCR4 地址连续，TIM_CHANNEL_x 的值为 4 * (x - 1)
+    hpwm->ccr = &hpwm->htim->Instance->CCR1 + (hpwm->channel >> 2U);
+}
+
+/**
+ * 未经 PWM_Init 的零初始化对象 (ccr 为 NULL) 补做初始化，避免向空指针写入
+ * @param hpwm pwm handle
+ * @return CCR 寄存器
+ */
+static inline volatile uint32_t* pwm_ccr(PWM_t* hpwm)
+{
+    if (hpwm->ccr == NULL)
+        PWM_Init(hpwm);
+    return hpwm->ccr;
+}
+
 static inline void PWM_Start(PWM_t* hpwm)
 {
+    PWM_Init(hpwm);
     HAL_TIM_PWM_Start(hpwm->htim, hpwm->channel);
 }
 
@@ -48,18 +83,49 @@ static inline void PWM_Stop(PWM_t* hpwm)
 
 static inline void PWM_SetCompare(PWM_t* hpwm, const uint32_t compare)
 {
-    if (compare <= __HAL_TIM_GET_AUTORELOAD(hpwm->htim))
-        __HAL_TIM_SET_COMPARE(hpwm->htim, hpwm->channel, compare);
+    volatile uint32_t* ccr = pwm_ccr(hpwm);
+    if (compare <= hpwm->arr)
+        *ccr = compare;
 }
 
+/**
+ * 设置占空比
+ * @param hpwm pwm handle
+ * @param duty_circle 占空比 [0, 1]，超出范围会被限幅
+ */
 static inline void PWM_SetDutyCircle(PWM_t* hpwm, const float duty_circle)
 {
-    if (duty_circle < 0.0f)
-        PWM_SetCompare(hpwm, 0);
-    else if (duty_circle > 1.0f)
-        PWM_SetCompare(hpwm, __HAL_TIM_GET_AUTORELOAD(hpwm->htim));
+    volatile uint32_t* ccr = pwm_ccr(hpwm);
+    if (duty_circle <= 0.0f)
+        *ccr = 0;
+    else if (duty_circle >= 1.0f)
+        *ccr = hpwm->arr;
     else
-        PWM_SetCompare(hpwm, __HAL_TIM_GET_AUTORELOAD(hpwm->htim) * duty_circle + 0.5);
+        *ccr = (uint32_t) ((float) hpwm->arr * duty_circle + 0.5f);
+}
+
+/**
+ * 设置占空比 (Q15)
+ * @param hpwm pwm handle
+ * @param duty_q15 占空比 [0, 32767] 对应 [0, 1)，负数按 0 处理
+ */
+static inline void PWM_SetDutyQ15(PWM_t* hpwm, const int16_t duty_q15)
+{
+    volatile uint32_t* ccr  = pwm_ccr(hpwm);
+    const uint32_t     duty = duty_q15 > 0 ? (uint32_t) duty_q15 : 0U;
+    *ccr                    = (uint32_t) (((uint64_t) hpwm->arr * duty + (1U << 14)) >> 15);
+}
+
+/**
+ * 设置占空比 (Q31)
+ * @param hpwm pwm handle
+ * @param duty_q31 占空比 [0, 0x7FFFFFFF] 对应 [0, 1)，负数按 0 处理
+ */
+static inline void PWM_SetDutyQ31(PWM_t* hpwm, const int32_t duty_q31)
+{
+    volatile uint32_t* ccr  = pwm_ccr(hpwm);
+    const uint32_t     duty = duty_q31 > 0 ? (uint32_t) duty_q31 : 0U;
+    *ccr                    = (uint32_t) (((uint64_t) hpwm->arr * duty + (1U << 30)) >> 31);
 }
 
 #ifdef __cplusplus
@@ -0,0 +1,201 @@
+/**
+ * @file    motor_ctrl_group.c
+ * @author  syhanjin
+ * @date    2026-10-17
+ */
+#include "motor_ctrl_group.h"
+
+#include <math.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * 写入单个成员的 PID 参数并清空状态
+ */
+static void group_pid_init(MotorCtrlGroup_PID_t*   pid,
+                           const size_t            index,
+                           const MotorPID_Config_t config)
+{
+    pid->Kp[index]             = config.Kp;
+    pid->Ki[index]             = config.Ki;
+    pid->Kd[index]             = config.Kd;
+    pid->abs_output_max[index] = config.abs_output_max;
+
+    pid->ref[index]         = 0.0f;
+    pid->fdb[index]         = 0.0f;
+    pid->prev_error1[index] = 0.0f;
+    pid->prev_error2[index] = 0.0f;
+    pid->output[index]      = 0.0f;
+}
+
+/**
+ * 对前 n 个成员执行增量式 PID 计算
+ *
+ * 循环体内没有分支和函数调用，各数组互不重叠，
+ * 在主机上可被自动向量化，在 M4 上每个成员只需一次连续的读写
+ * @attention 计算与 MotorPID_Calculate 相同，修改任意一方时需要同步修改另一方，
+ *            MOTOR_CTRL_GROUP_SELF_CHECK 会在初始化时校验两者一致
+ */
+static void group_pid_calculate(MotorCtrlGroup_PID_t* pid, const size_t n)
+{
+    const float* restrict Kp      = pid->Kp;
+    const float* restrict Ki      = pid->Ki;
+    const float* restrict Kd      = pid->Kd;
+    const float* restrict out_max = pid->abs_output_max;
+    const float* restrict ref     = pid->ref;
+    const float* restrict fdb     = pid->fdb;
+    float* restrict       e1      = pid->prev_error1;
+    float* restrict       e2      = pid->prev_error2;
+    float* restrict       output  = pid->output;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        const float error = ref[i] - fdb[i];
+        float       out   = output[i] + Kp[i] * (error - e1[i]) + Ki[i] * error +
+                    Kd[i] * (error - 2.0f * e1[i] + e2[i]);
+        out       = out > out_max[i] ? out_max[i] : out;
+        out       = out < -out_max[i] ? -out_max[i] : out;
+        output[i] = out;
+        e2[i]     = e1[i];
+        e1[i]     = error;
+    }
+}
+
+#if MOTOR_CTRL_GROUP_SELF_CHECK
+/**
+ * 用同一组输入分别驱动 MotorPID_Calculate 和 group_pid_calculate，比较每一步的输出
+ *
+ * 输入覆盖正负误差和输出限幅，两者的计算若出现分歧 (如 MotorPID_t 的算法被修改) 会在这里暴露
+ * @param pid 用作临时空间的批量 PID，校验后内容无意义
+ * @return 是否一致
+ */
+static bool group_pid_self_check(MotorCtrlGroup_PID_t* pid)
+{
+    static const MotorPID_Config_t config = {
+        .Kp = 1.5f, .Ki = 0.25f, .Kd = 0.5f, .abs_output_max = 12.0f
+    };
+    static const float ref[] = { 10.0f, 10.0f, -4.0f, -4.0f, 7.0f, 0.0f };
+    static const float fdb[] = { 0.0f, 3.0f, 2.0f, -1.0f, -3.0f, 0.5f };
+
+    MotorPID_t scalar;
+    MotorPID_Init(&scalar, config);
+    group_pid_init(pid, 0, config);
+
+    for (size_t k = 0; k < sizeof(ref) / sizeof(ref[0]); k++)
+    {
+        scalar.ref = pid->ref[0] = ref[k];
+        scalar.fdb = pid->fdb[0] = fdb[k];
+        MotorPID_Calculate(&scalar);
+        group_pid_calculate(pid, 1);
+        if (fabsf(scalar.output - pid->output[0]) > 1e-4f * (1.0f + fabsf(scalar.output)))
+            return false;
+    }
+    return true;
+}
+#endif
+
+/**
+ * 初始化位置环控制组
+ * @param group 控制组
+ * @param config 配置
+ * @attention 组内电机必须由外部 PID 输出电流 (或占空比) 控制，
+ *            内部环模式的电机请使用 Motor_PosCtrl_t
+ * @attention 计算函数不会对输出限幅，务必将内环输出限幅设为最大电流值
+ * @attention 成员数超过 MOTOR_CTRL_GROUP_MAX，或批量 PID 与 MotorPID_Calculate 不一致时
+ *            进入 MOTOR_CTRL_GROUP_ERROR_HANDLER
+ */
+void Motor_PosCtrlGroup_Init(Motor_PosCtrlGroup_t* group, const Motor_PosCtrlGroupConfig_t* config)
+{
+    memset(group, 0, sizeof(Motor_PosCtrlGroup_t));
+
+    if (config->count > MOTOR_CTRL_GROUP_MAX)
+    {
+        // 成员数超出容量，电机将不受控制，需要增大 MOTOR_CTRL_GROUP_MAX
+        MOTOR_CTRL_GROUP_ERROR_HANDLER();
+        return;
+    }
+
+#if MOTOR_CTRL_GROUP_SELF_CHECK
+    const bool pid_consistent = group_pid_self_check(&group->position_pid);
+    memset(&group->position_pid, 0, sizeof(MotorCtrlGroup_PID_t));
+    if (!pid_consistent)
+    {
+        // 批量 PID 与 MotorPID_Calculate 的算法不一致，需要同步修改 group_pid_calculate
+        MOTOR_CTRL_GROUP_ERROR_HANDLER();
+        return;
+    }
+#endif
+
+    group->count              = config->count;
+    group->pos_vel_freq_ratio = config->pos_vel_freq_ratio ? config->pos_vel_freq_ratio : 1;
+
+    for (size_t i = 0; i < config->count; i++)
+    {
+        const Motor_PosCtrlConfig_t* member = &config->members[i];
+
+        group->motor[i] = member->motor;
+        group->ops[i]   = Motor_GetOps(member->motor_type);
+
+        group_pid_init(&group->position_pid, i, member->position_pid);
+        group_pid_init(&group->velocity_pid, i, member->velocity_pid);
+
+        group->settle.error_threshold[i] = member->error_threshold;
+        group->settle.count_max[i] = member->settle_count_max ? member->settle_count_max : 50;
+    }
+
+    group->enable = false;
+}
+
+/**
+ * 位置环控制组计算
+ *
+ * 依次执行：读取反馈 -> 位置环 (按频率比) -> 速度环 -> 下发输出
+ * @param group 控制组
+ */
+void Motor_PosCtrlGroupUpdate(Motor_PosCtrlGroup_t* group)
+{
+    if (!group->enable)
+        return;
+
+    const size_t n = group->count;
+
+    /* 读取反馈 */
+    for (size_t i = 0; i < n; i++)
+    {
+        const Motor_State_t state = group->ops[i]->get_state(group->motor[i]);
+
+        group->position_pid.fdb[i] = state.angle;
+        group->velocity_pid.fdb[i] = state.velocity;
+    }
+
+    /* 就位判断 */
+    for (size_t i = 0; i < n; i++)
+    {
+        const float error = group->position_pid.fdb[i] - group->position[i];
+        const bool  in    = error < group->settle.error_threshold[i] &&
+                        error > -group->settle.error_threshold[i];
+        group->settle.counter[i] = in ? group->settle.counter[i] + 1 : 0;
+    }
+
+    if (++group->tick == group->pos_vel_freq_ratio)
+    {
+        memcpy(group->position_pid.ref, group->position, n * sizeof(float));
+        group_pid_calculate(&group->position_pid, n);
+        group->tick = 0;
+    }
+
+    memcpy(group->velocity_pid.ref, group->position_pid.output, n * sizeof(float));
+    group_pid_calculate(&group->velocity_pid, n);
+
+    /* 下发输出 */
+    for (size_t i = 0; i < n; i++)
+        group->ops[i]->apply_output(group->motor[i], group->velocity_pid.output[i]);
+}
+
+#ifdef __cplusplus
+}
+#endif
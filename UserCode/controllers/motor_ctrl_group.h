@@ -0,0 +1,145 @@
+/**
+ * @file    motor_ctrl_group.h
+ * @author  syhanjin
+ * @date    2026-10-17
+ * @brief   batched position controller group in structure-of-arrays layout.
+ *
+ * 将多个位置环控制对象的目标、反馈、增益与积分状态按成员连续存放，
+ * 每个周期先统一读取反馈，再对全组执行一次紧凑的 PID 循环，最后统一下发输出。
+ *
+ * --------------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Project repository: https://github.com/HITSZ-WTR2026/motor_drivers
+ */
+#ifndef MOTOR_CTRL_GROUP_H
+#define MOTOR_CTRL_GROUP_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "interfaces/motor_if.h"
+
+/**
+ * 控制组最大成员数
+ */
+#ifndef MOTOR_CTRL_GROUP_MAX
+#    define MOTOR_CTRL_GROUP_MAX (24U)
+#endif
+
+#ifndef MOTOR_CTRL_GROUP_ERROR_HANDLER
+#    define MOTOR_CTRL_GROUP_ERROR_HANDLER() Error_Handler()
+#endif
+
+/**
+ * 初始化时是否校验批量 PID 与 MotorPID_Calculate 的结果一致
+ */
+#ifndef MOTOR_CTRL_GROUP_SELF_CHECK
+#    define MOTOR_CTRL_GROUP_SELF_CHECK (1)
+#endif
+
+/**
+ * 批量 PID 数据 (SoA)
+ *
+ * 每个数组的第 i 项属于组内第 i 个成员
+ */
+typedef struct
+{
+    float Kp[MOTOR_CTRL_GROUP_MAX];
+    float Ki[MOTOR_CTRL_GROUP_MAX];
+    float Kd[MOTOR_CTRL_GROUP_MAX];
+    float abs_output_max[MOTOR_CTRL_GROUP_MAX];
+
+    float ref[MOTOR_CTRL_GROUP_MAX];
+    float fdb[MOTOR_CTRL_GROUP_MAX];
+
+    float prev_error1[MOTOR_CTRL_GROUP_MAX]; ///< 上一次误差
+    float prev_error2[MOTOR_CTRL_GROUP_MAX]; ///< 上上次误差
+    float output[MOTOR_CTRL_GROUP_MAX];      ///< 输出，同时为增量累加的状态
+} MotorCtrlGroup_PID_t;
+
+/**
+ * 位置环控制组
+ *
+ * @note 组内成员均为完全外部 PID 控制 (MOTOR_CTRL_EXTERNAL_PID)
+ */
+typedef struct
+{
+    bool     enable;             ///< 是否启用控制
+    size_t   count;              ///< 成员数
+    uint32_t pos_vel_freq_ratio; ///< 内外环频率比
+    uint32_t tick;               ///< 计数
+
+    void*              motor[MOTOR_CTRL_GROUP_MAX]; ///< 受控电机
+    const Motor_Ops_t* ops[MOTOR_CTRL_GROUP_MAX];   ///< 受控电机操作表
+
+    float position[MOTOR_CTRL_GROUP_MAX]; ///< 当前控制的位置
+
+    MotorCtrlGroup_PID_t position_pid; ///< 外环，位置环
+    MotorCtrlGroup_PID_t velocity_pid; ///< 内环，速度环
+
+    struct
+    {
+        float    error_threshold[MOTOR_CTRL_GROUP_MAX]; ///< 允许的误差范围
+        uint32_t count_max[MOTOR_CTRL_GROUP_MAX];       ///< 保持的计数范围
+        uint32_t counter[MOTOR_CTRL_GROUP_MAX];         ///< 就位计数
+    } settle;                                           ///< 就位判断
+} Motor_PosCtrlGroup_t;
+
+/**
+ * 位置环控制组配置
+ */
+typedef struct
+{
+    const Motor_PosCtrlConfig_t* members;            ///< 成员配置，仅使用其中的电机、PID 与就位参数
+    size_t                       count;              ///< 成员数
+    uint32_t                     pos_vel_freq_ratio; ///< 全组共用的内外环频率比
+} Motor_PosCtrlGroupConfig_t;
+
+void Motor_PosCtrlGroup_Init(Motor_PosCtrlGroup_t* group, const Motor_PosCtrlGroupConfig_t* config);
+void Motor_PosCtrlGroupUpdate(Motor_PosCtrlGroup_t* group);
+
+/**
+ * 设置成员位置环目标值
+ * @param group 控制组
+ * @param index 成员序号
+ * @param ref 目标值 (unit: deg)
+ */
+static inline void Motor_PosCtrlGroup_SetRef(Motor_PosCtrlGroup_t* group,
+                                             const size_t          index,
+                                             const float           ref)
+{
+    group->position[index]       = ref;
+    group->settle.counter[index] = 0;
+}
+
+/**
+ * 判断成员是否就位
+ * @param group 控制组
+ * @param index 成员序号
+ * @return 是否就位
+ */
+static inline bool Motor_PosCtrlGroup_IsSettle(const Motor_PosCtrlGroup_t* group,
+                                               const size_t                index)
+{
+    return group->settle.counter[index] >= group->settle.count_max[index];
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MOTOR_CTRL_GROUP_H
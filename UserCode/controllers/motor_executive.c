@@ -0,0 +1,179 @@
+/**
+ * @file    motor_executive.c
+ * @author  syhanjin
+ * @date    2026-10-17
+ */
+#include "motor_executive.h"
+
+#include <string.h>
+#include "bsp/cycle_profiler.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * 定时器 -> 执行器
+ */
+static MotorExec_t* map[MOTOR_EXEC_NUM];
+static size_t       map_size = 0;
+
+static void exec_tim_callback(TIM_HandleTypeDef* htim)
+{
+    for (size_t i = 0; i < map_size; i++)
+        if (map[i]->htim == htim)
+        {
+            MotorExec_Tick(map[i]);
+            return;
+        }
+}
+
+/**
+ * 执行器是否已登记到定时器回调表
+ */
+static bool exec_registered(const MotorExec_t* exec)
+{
+    for (size_t i = 0; i < map_size; i++)
+        if (map[i] == exec)
+            return true;
+    return false;
+}
+
+/**
+ * 初始化执行器
+ * @param exec 执行器
+ * @param config 配置
+ * @attention 执行器数量超过 MOTOR_EXEC_NUM 时进入 MOTOR_EXEC_ERROR_HANDLER
+ */
+void MotorExec_Init(MotorExec_t* exec, const MotorExec_Config_t* config)
+{
+    memset(exec, 0, sizeof(MotorExec_t));
+    exec->htim             = config->htim;
+    exec->items            = config->items;
+    exec->capacity         = config->capacity;
+    exec->deadline_cycles  = config->deadline_us * (SystemCoreClock / 1000000U);
+    exec->overrun_callback = config->overrun_callback;
+
+    Profile_Enable(); // 阶段耗时和截止时间由 DWT 周期计数器计时
+
+    for (size_t i = 0; i < map_size; i++)
+        if (map[i] == exec || map[i]->htim == exec->htim)
+        {
+            map[i] = exec;
+            return;
+        }
+    if (map_size >= MOTOR_EXEC_NUM)
+    {
+        // 回调表已满，定时器回调找不到该执行器，控制循环不会运行，需要增大 MOTOR_EXEC_NUM
+        MOTOR_EXEC_ERROR_HANDLER();
+        return;
+    }
+    map[map_size++] = exec;
+}
+
+/**
+ * 注册执行项
+ *
+ * 同一阶段内按注册顺序执行
+ * @param exec 执行器
+ * @param phase 阶段
+ * @param task 任务
+ * @param context 任务参数
+ * @return 是否注册成功
+ */
+bool MotorExec_Register(MotorExec_t*            exec,
+                        const MotorExec_Phase_t phase,
+                        const MotorExec_Task_t  task,
+                        void*                   context)
+{
+    if (exec->count >= exec->capacity || phase >= MOTOR_EXEC_PHASE_COUNT || task == NULL)
+        return false;
+
+    // 插入到同阶段最后一项之后，保持按阶段有序
+    size_t pos = exec->count;
+    while (pos > 0 && exec->items[pos - 1].phase > phase)
+    {
+        exec->items[pos] = exec->items[pos - 1];
+        pos--;
+    }
+    exec->items[pos] = (MotorExec_Item_t) { .phase = phase, .task = task, .context = context };
+    exec->count++;
+    return true;
+}
+
+/**
+ * 注册定时器回调并启动定时器
+ * @note 未能登记的执行器 (见 MotorExec_Init) 不会启动定时器
+ * @param exec 执行器
+ */
+void MotorExec_Start(MotorExec_t* exec)
+{
+    if (!exec_registered(exec))
+        return;
+    HAL_TIM_RegisterCallback(exec->htim, HAL_TIM_PERIOD_ELAPSED_CB_ID, exec_tim_callback);
+    HAL_TIM_Base_Start_IT(exec->htim);
+}
+
+/**
+ * 停止定时器
+ * @param exec 执行器
+ */
+void MotorExec_Stop(MotorExec_t* exec)
+{
+    HAL_TIM_Base_Stop_IT(exec->htim);
+}
+
+/**
+ * 执行一个节拍
+ *
+ * 一般由定时器回调调用，也可以在用户自己的定时器回调中直接调用
+ * @param exec 执行器
+ */
+void MotorExec_Tick(MotorExec_t* exec)
+{
+    const uint32_t start = DWT->CYCCNT;
+    uint32_t       mark  = start;
+    size_t         i     = 0;
+
+    for (uint32_t phase = 0; phase < MOTOR_EXEC_PHASE_COUNT; phase++)
+    {
+        for (; i < exec->count && exec->items[i].phase == phase; i++)
+            exec->items[i].task(exec->items[i].context);
+
+        const uint32_t now    = DWT->CYCCNT;
+        const uint32_t cycles = now - mark;
+        mark                  = now;
+
+        exec->stats.phase_cycles[phase] = cycles;
+        if (cycles > exec->stats.phase_max_cycles[phase])
+            exec->stats.phase_max_cycles[phase] = cycles;
+    }
+
+    const uint32_t cycles   = mark - start;
+    exec->stats.tick_cycles = cycles;
+    if (cycles > exec->stats.tick_max_cycles)
+        exec->stats.tick_max_cycles = cycles;
+    exec->stats.tick_count++;
+
+    exec->stats.overrun = exec->deadline_cycles != 0 && cycles > exec->deadline_cycles;
+    if (exec->stats.overrun)
+    {
+        exec->stats.overrun_count++;
+        if (exec->overrun_callback != NULL)
+            exec->overrun_callback(exec, cycles);
+    }
+}
+
+/**
+ * 清空运行统计
+ * @param exec 执行器
+ */
+void MotorExec_ResetStats(MotorExec_t* exec)
+{
+    memset(&exec->stats, 0, sizeof(exec->stats));
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,140 @@
+/**
+ * @file    motor_executive.h
+ * @author  syhanjin
+ * @date    2026-10-17
+ * @brief   real-time control executive with fixed phases and deadline monitoring.
+ *
+ * 执行器接管控制定时器，每个节拍按固定顺序执行各阶段注册的任务：
+ *   反馈快照 -> 轨迹更新 -> 控制计算 -> 输出打包 -> 总线发送
+ * 并记录每个阶段的耗时，节拍总耗时超过截止时间时计为超时。
+ *
+ * --------------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Project repository: https://github.com/HITSZ-WTR2026/motor_drivers
+ */
+#ifndef MOTOR_EXECUTIVE_H
+#define MOTOR_EXECUTIVE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "main.h"
+
+/**
+ * 执行器数量上限 (每个执行器占用一个定时器)
+ */
+#ifndef MOTOR_EXEC_NUM
+#    define MOTOR_EXEC_NUM (2)
+#endif
+
+#ifndef MOTOR_EXEC_ERROR_HANDLER
+#    define MOTOR_EXEC_ERROR_HANDLER() Error_Handler()
+#endif
+
+/**
+ * 执行阶段，按枚举顺序执行
+ */
+typedef enum
+{
+    MOTOR_EXEC_PHASE_FEEDBACK = 0U, ///< 反馈快照，如编码器解码
+    MOTOR_EXEC_PHASE_TRAJECTORY,    ///< 轨迹更新
+    MOTOR_EXEC_PHASE_CONTROL,       ///< 控制计算
+    MOTOR_EXEC_PHASE_OUTPUT,        ///< 输出打包
+    MOTOR_EXEC_PHASE_FLUSH,         ///< 总线发送，如 DJI_SendSetIqCommand
+
+    MOTOR_EXEC_PHASE_COUNT
+} MotorExec_Phase_t;
+
+/**
+ * 执行任务
+ */
+typedef void (*MotorExec_Task_t)(void* context);
+
+/**
+ * 执行项
+ */
+typedef struct
+{
+    MotorExec_Phase_t phase;   ///< 所属阶段
+    MotorExec_Task_t  task;    ///< 任务
+    void*             context; ///< 任务参数
+} MotorExec_Item_t;
+
+typedef struct MotorExec MotorExec_t;
+
+/**
+ * 超时回调，在定时器中断中调用
+ */
+typedef void (*MotorExec_OverrunCallback_t)(MotorExec_t* exec, uint32_t cycles);
+
+/**
+ * 执行器
+ */
+struct MotorExec
+{
+    TIM_HandleTypeDef* htim; ///< 控制定时器
+
+    MotorExec_Item_t* items;    ///< 执行项存储，按阶段排序
+    size_t            capacity; ///< 执行项容量
+    size_t            count;    ///< 已注册的执行项数
+
+    uint32_t deadline_cycles; ///< 截止时间 (unit: cycle)
+
+    struct
+    {
+        uint32_t phase_cycles[MOTOR_EXEC_PHASE_COUNT];     ///< 上一节拍各阶段耗时 (unit: cycle)
+        uint32_t phase_max_cycles[MOTOR_EXEC_PHASE_COUNT]; ///< 各阶段最大耗时 (unit: cycle)
+        uint32_t tick_cycles;                              ///< 上一节拍总耗时 (unit: cycle)
+        uint32_t tick_max_cycles;                          ///< 节拍最大总耗时 (unit: cycle)
+        uint32_t tick_count;                               ///< 节拍数
+        uint32_t overrun_count;                            ///< 超时节拍数
+        bool     overrun;                                  ///< 上一节拍是否超时
+    } stats; ///< 运行统计
+
+    MotorExec_OverrunCallback_t overrun_callback; ///< 超时回调
+};
+
+/**
+ * 执行器配置
+ */
+typedef struct
+{
+    TIM_HandleTypeDef* htim;        ///< 控制定时器，需在 CubeMX 中启用 Register Callback
+    MotorExec_Item_t*  items;       ///< 执行项存储，由调用者提供
+    size_t             capacity;    ///< 执行项容量
+    uint32_t           deadline_us; ///< 截止时间，一般不超过定时器周期 (unit: us)
+
+    MotorExec_OverrunCallback_t overrun_callback; ///< 超时回调，可为 NULL
+} MotorExec_Config_t;
+
+void MotorExec_Init(MotorExec_t* exec, const MotorExec_Config_t* config);
+bool MotorExec_Register(MotorExec_t*      exec,
+                        MotorExec_Phase_t phase,
+                        MotorExec_Task_t  task,
+                        void*             context);
+void MotorExec_Start(MotorExec_t* exec);
+void MotorExec_Stop(MotorExec_t* exec);
+void MotorExec_Tick(MotorExec_t* exec);
+void MotorExec_ResetStats(MotorExec_t* exec);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MOTOR_EXECUTIVE_H
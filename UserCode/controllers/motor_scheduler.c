@@ -0,0 +1,219 @@
+/**
+ * @file    motor_scheduler.c
+ * @author  syhanjin
+ * @date    2026-10-17
+ */
+#include "motor_scheduler.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+static uint32_t gcd(uint32_t a, uint32_t b)
+{
+    while (b != 0)
+    {
+        const uint32_t t = a % b;
+        a                = b;
+        b                = t;
+    }
+    return a;
+}
+
+/**
+ * 为分频 divider 的新任务选择相位
+ *
+ * 任务 (d1, p1) 与 (d2, p2) 会在同一节拍执行当且仅当 p1 ≡ p2 (mod gcd(d1, d2))，
+ * 以已有任务的执行频率 (1 / d) 加权统计冲突，选取冲突最少的相位
+ */
+static uint32_t choose_phase(const MotorSched_t* sched, const uint32_t divider)
+{
+    uint32_t best_phase = 0;
+    float    best_cost  = 0.0f;
+
+    for (uint32_t phase = 0; phase < divider; phase++)
+    {
+        float cost = 0.0f;
+        for (size_t i = 0; i < sched->count; i++)
+        {
+            const MotorSched_Entry_t* entry = &sched->entries[i];
+            const uint32_t            g     = gcd(divider, entry->divider);
+            if (phase % g == entry->phase % g)
+                cost += 1.0f / (float) entry->divider;
+        }
+        if (phase == 0 || cost < best_cost)
+        {
+            best_phase = phase;
+            best_cost  = cost;
+        }
+    }
+    return best_phase;
+}
+
+/**
+ * 初始化调度器
+ * @param sched 调度器
+ * @param config 配置
+ */
+void MotorSched_Init(MotorSched_t* sched, const MotorSched_Config_t* config)
+{
+    sched->base_freq = config->base_freq;
+    sched->entries   = config->entries;
+    sched->capacity  = config->capacity;
+    sched->count     = 0;
+}
+
+/**
+ * 添加调度任务
+ * @param sched 调度器
+ * @param task 任务
+ * @param context 任务参数
+ * @param freq 任务频率 (unit: Hz)，必须整除基准频率
+ * @return 是否添加成功
+ */
+bool MotorSched_Add(MotorSched_t*           sched,
+                    const MotorSched_Task_t task,
+                    void*                   context,
+                    const uint32_t          freq)
+{
+    if (sched->count >= sched->capacity || freq == 0 || freq > sched->base_freq ||
+        sched->base_freq % freq != 0)
+        return false;
+
+    const uint32_t divider = sched->base_freq / freq;
+    const uint32_t phase   = choose_phase(sched, divider);
+
+    sched->entries[sched->count] = (MotorSched_Entry_t) {
+        .task    = task,
+        .context = context,
+        .divider = divider,
+        .phase   = phase,
+        .counter = phase,
+    };
+    sched->count++;
+    return true;
+}
+
+static void pos_ctrl_task(void* context)
+{
+    Motor_PosCtrlUpdate(context);
+}
+
+static void vel_ctrl_task(void* context)
+{
+    Motor_VelCtrlUpdate(context);
+}
+
+static void cur_ctrl_task(void* context)
+{
+    Motor_CurCtrlUpdate(context);
+}
+
+/**
+ * 在执行位置环控制对象前，按调度项记录的外环相位设置控制对象的计数
+ *
+ * 外环相位保存在调度项中，控制对象的 count 被清零 (如控制权切换) 或暂停更新后也不会打乱错开
+ */
+static void pos_ctrl_sync(MotorSched_Entry_t* entry)
+{
+    if (entry->sub_divider <= 1)
+        return;
+
+    Motor_PosCtrl_t* hctrl = entry->context;
+    // 本次需要计算外环时，令 ++count 恰好等于 pos_vel_freq_ratio
+    hctrl->count       = entry->sub_counter == 0 ? hctrl->pos_vel_freq_ratio - 1 : 0;
+    entry->sub_counter = (entry->sub_counter == 0 ? entry->sub_divider : entry->sub_counter) - 1;
+}
+
+/**
+ * 添加位置环控制对象
+ *
+ * 控制对象以速度环频率更新，完全外部 PID 控制时位置环频率通过 pos_vel_freq_ratio 实现，
+ * 不同控制对象的位置环计算也会错开到不同的速度环节拍；
+ * 内部速度环 / 位置环模式下位置环必须每次都计算，此时忽略 pos_freq
+ * @param sched 调度器
+ * @param hctrl 位置环控制对象
+ * @param pos_freq 位置环频率 (unit: Hz)，必须整除速度环频率
+ * @param vel_freq 速度环频率 (unit: Hz)，必须整除基准频率
+ * @return 是否添加成功
+ */
+bool MotorSched_AddPosCtrl(MotorSched_t*    sched,
+                           Motor_PosCtrl_t* hctrl,
+                           const uint32_t   pos_freq,
+                           const uint32_t   vel_freq)
+{
+    if (pos_freq == 0 || pos_freq > vel_freq || vel_freq % pos_freq != 0)
+        return false;
+
+    const uint32_t ratio = hctrl->ctrl_mode == MOTOR_CTRL_EXTERNAL_PID ? vel_freq / pos_freq : 1;
+    uint32_t       outer = 0; // 已有的同频率比位置环数量，用于错开位置环节拍
+    for (size_t i = 0; i < sched->count; i++)
+        if (sched->entries[i].task == pos_ctrl_task && sched->entries[i].sub_divider == ratio)
+            outer++;
+
+    if (!MotorSched_Add(sched, pos_ctrl_task, hctrl, vel_freq))
+        return false;
+
+    if (hctrl->ctrl_mode == MOTOR_CTRL_EXTERNAL_PID)
+    {
+        // 频率比为 1 时同样覆盖初始化时配置的值，计数清零避免 count 已越过新的频率比
+        hctrl->pos_vel_freq_ratio = ratio;
+        hctrl->count              = 0;
+    }
+    if (ratio > 1)
+    {
+        MotorSched_Entry_t* entry = &sched->entries[sched->count - 1];
+        entry->sub_divider        = ratio;
+        entry->sub_counter        = outer % ratio;
+    }
+    return true;
+}
+
+/**
+ * 添加速度环控制对象
+ * @param sched 调度器
+ * @param hctrl 速度环控制对象
+ * @param freq 更新频率 (unit: Hz)，必须整除基准频率
+ * @return 是否添加成功
+ */
+bool MotorSched_AddVelCtrl(MotorSched_t* sched, Motor_VelCtrl_t* hctrl, const uint32_t freq)
+{
+    return MotorSched_Add(sched, vel_ctrl_task, hctrl, freq);
+}
+
+/**
+ * 添加电流 (力矩) 控制对象
+ * @param sched 调度器
+ * @param hctrl 电流控制对象
+ * @param freq 更新频率 (unit: Hz)，必须整除基准频率
+ * @return 是否添加成功
+ */
+bool MotorSched_AddCurCtrl(MotorSched_t* sched, Motor_CurCtrl_t* hctrl, const uint32_t freq)
+{
+    return MotorSched_Add(sched, cur_ctrl_task, hctrl, freq);
+}
+
+/**
+ * 调度器节拍，在基准频率的定时器中断中调用
+ * @param sched 调度器
+ */
+void MotorSched_Tick(MotorSched_t* sched)
+{
+    for (size_t i = 0; i < sched->count; i++)
+    {
+        MotorSched_Entry_t* entry = &sched->entries[i];
+        if (entry->counter == 0)
+        {
+            entry->counter = entry->divider;
+            if (entry->task == pos_ctrl_task)
+                pos_ctrl_sync(entry);
+            entry->task(entry->context);
+        }
+        entry->counter--;
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,91 @@
+/**
+ * @file    motor_scheduler.h
+ * @author  syhanjin
+ * @date    2026-10-17
+ * @brief   multi-rate loop scheduler for motor controllers.
+ *
+ * 调度器由一个固定频率的基准定时器驱动，每个控制对象声明自己需要的更新频率，
+ * 调度器将其换算为基准频率的分频，并在各子节拍间错开相位，使每个节拍的计算量尽量均匀。
+ *
+ * --------------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Project repository: https://github.com/HITSZ-WTR2026/motor_drivers
+ */
+#ifndef MOTOR_SCHEDULER_H
+#define MOTOR_SCHEDULER_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include "interfaces/motor_if.h"
+
+/**
+ * 调度任务
+ */
+typedef void (*MotorSched_Task_t)(void* context);
+
+/**
+ * 调度项
+ */
+typedef struct
+{
+    MotorSched_Task_t task;        ///< 任务
+    void*             context;     ///< 任务参数
+    uint32_t          divider;     ///< 分频 (基准频率 / 任务频率)
+    uint32_t          phase;       ///< 相位 (0 ~ divider - 1)
+    uint32_t          counter;     ///< 距离下次执行的节拍数
+    uint32_t          sub_divider; ///< 位置环外环分频 (内环次数 / 外环次数)，0 表示不由调度器决定
+    uint32_t          sub_counter; ///< 距离下次外环执行的次数
+} MotorSched_Entry_t;
+
+/**
+ * 调度器
+ */
+typedef struct
+{
+    uint32_t            base_freq; ///< 基准频率 (unit: Hz)
+    MotorSched_Entry_t* entries;   ///< 调度项存储
+    size_t              capacity;  ///< 调度项容量
+    size_t              count;     ///< 已添加的调度项数
+} MotorSched_t;
+
+/**
+ * 调度器配置
+ */
+typedef struct
+{
+    uint32_t            base_freq; ///< 基准频率，即调用 MotorSched_Tick 的频率 (unit: Hz)
+    MotorSched_Entry_t* entries;   ///< 调度项存储，由调用者提供
+    size_t              capacity;  ///< 调度项容量
+} MotorSched_Config_t;
+
+void MotorSched_Init(MotorSched_t* sched, const MotorSched_Config_t* config);
+bool MotorSched_Add(MotorSched_t* sched, MotorSched_Task_t task, void* context, uint32_t freq);
+bool MotorSched_AddPosCtrl(MotorSched_t*    sched,
+                           Motor_PosCtrl_t* hctrl,
+                           uint32_t         pos_freq,
+                           uint32_t         vel_freq);
+bool MotorSched_AddVelCtrl(MotorSched_t* sched, Motor_VelCtrl_t* hctrl, uint32_t freq);
+bool MotorSched_AddCurCtrl(MotorSched_t* sched, Motor_CurCtrl_t* hctrl, uint32_t freq);
+void MotorSched_Tick(MotorSched_t* sched);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MOTOR_SCHEDULER_H
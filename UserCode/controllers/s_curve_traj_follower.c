@@ -4,6 +4,7 @@
  * @date    2025-12-15
  */
 #include "s_curve_traj_follower.h"
+#include <string.h>
 
 #ifdef __cplusplus
 extern "C"
@@ -30,12 +31,14 @@ void SCurveTraj_Axis_Init(SCurveTrajFollower_Axis_t*             follower,
     follower->a_max           = config->a_max;
     follower->j_max           = config->j_max;
 
+    follower->origin  = 0;
     follower->now     = 0.0f;
     follower->running = false;
 
 #ifdef DEBUG
     follower->current_target = 0.0f;
 #endif
+    PROFILE_RESET(&follower->profile);
 }
 
 /**
@@ -50,23 +53,26 @@ void SCurveTraj_Axis_Update(SCurveTrajFollower_Axis_t* follower)
     if (!follower->running)
         return;
 
+    PROFILE_BEGIN();
     const float now = follower->now + follower->update_interval;
     follower->now   = now;
     // 计算速度前馈量
     const float ff_velocity = SCurve_CalcV(&follower->s, now);
     // 计算当前目标位置
-    const float target = SCurve_CalcX(&follower->s, now);
-    // 计算 PD 输出
+    const float      target = SCurve_CalcX(&follower->s, now);
+    const MotorPos_t origin = MotorPos_Load(&follower->origin);
+    // 计算 PD 输出，反馈为相对曲线起点的位移，在定点下相减
     follower->pd.ref = target;
-    follower->pd.fdb = MotorCtrl_GetAngle(follower->ctrl);
+    follower->pd.fdb = MotorPos_DiffDeg(MotorCtrl_GetPos(follower->ctrl), origin);
     PD_Calculate(&follower->pd);
     // 计算总速度
     const float velocity = ff_velocity + follower->pd.output;
 #ifdef DEBUG
-    follower->current_target = target;
+    follower->current_target = MotorPos_ToDeg(MotorPos_AddDeg(origin, target));
 #endif
     // 设置电机速度
     Motor_VelCtrl_SetRef(follower->ctrl, DPS2RPM(velocity));
+    PROFILE_END(&follower->profile);
 }
 
 /**
@@ -82,6 +88,7 @@ void SCurveTraj_Axis_ResetAll(SCurveTrajFollower_Axis_t* follower)
     memset(&follower->pd, 0, sizeof(follower->pd));
     Motor_VelCtrl_SetRef(follower->ctrl, 0);
     MotorCtrl_ResetAngle(follower->ctrl);
+    MotorPos_Store(&follower->origin, 0);
 }
 
 void SCurveTraj_Axis_Stop(SCurveTrajFollower_Axis_t* follower)
@@ -92,14 +99,20 @@ void SCurveTraj_Axis_Stop(SCurveTrajFollower_Axis_t* follower)
 }
 
 // 辅助函数
+/**
+ * 以当前位置为原点规划曲线
+ *
+ * 曲线只描述相对原点的位移，长时间运行后绝对角度很大时 float 的精度也不会影响规划
+ * @param distance 目标相对当前位置的位移 (unit: deg)
+ */
 static SCurve_Result_t axis_s_curve_init(SCurve_t*                        s,
                                          const SCurveTrajFollower_Axis_t* follower,
                                          const bool                       running,
-                                         const float                      target)
+                                         const float                      distance)
 {
     return SCurve_Init(s,
-                       MotorCtrl_GetAngle(follower->ctrl),    // 从当前位置起始,
-                       target,                                // 到目标位置
+                       0,                                     // 从当前位置起始,
+                       distance,                              // 到目标位置
                        MotorCtrl_GetVelocity(follower->ctrl), // 保证速度连续
                        running ? SCurve_CalcA(&follower->s, follower->now)
                                : 0, // 尽量保证加速度也连续,
@@ -120,8 +133,12 @@ SCurve_Result_t SCurveTraj_Axis_SetTarget(SCurveTrajFollower_Axis_t* follower, c
 
     follower->running = false;
 
-    const SCurve_Result_t r = axis_s_curve_init(&follower->s, follower, running, target);
+    const MotorPos_t origin   = MotorCtrl_GetPos(follower->ctrl);
+    const float      distance = MotorPos_DiffDeg(MotorPos_FromDeg(target), origin);
 
+    const SCurve_Result_t r = axis_s_curve_init(&follower->s, follower, running, distance);
+
+    MotorPos_Store(&follower->origin, origin);
     follower->now = 0;
     if (r == S_CURVE_SUCCESS)
         follower->running = true;
@@ -146,11 +163,11 @@ SCurve_Result_t SCurveTraj_Axis_SetTargetRelPos(SCurveTrajFollower_Axis_t* follo
 
     follower->running = false;
 
-    const float current_pos = MotorCtrl_GetAngle(follower->ctrl);
+    const MotorPos_t origin = MotorCtrl_GetPos(follower->ctrl);
 
-    const SCurve_Result_t r =
-            axis_s_curve_init(&follower->s, follower, running, current_pos + delta_pos);
+    const SCurve_Result_t r = axis_s_curve_init(&follower->s, follower, running, delta_pos);
 
+    MotorPos_Store(&follower->origin, origin);
     follower->now = 0;
     if (r == S_CURVE_SUCCESS)
         follower->running = true;
@@ -174,7 +191,178 @@ float SCurveTraj_Axis_EstimateDuration(const SCurveTrajFollower_Axis_t* follower
 {
     // 临时规划器
     SCurve_t              temps;
-    const SCurve_Result_t r = axis_s_curve_init(&temps, follower, follower->running, target);
+    const float           distance =
+            MotorPos_DiffDeg(MotorPos_FromDeg(target), MotorCtrl_GetPos(follower->ctrl));
+    const SCurve_Result_t r = axis_s_curve_init(&temps, follower, follower->running, distance);
+    if (r != S_CURVE_SUCCESS)
+        return -1.0f;
+    return temps.total_time;
+}
+
+/**
+ * 初始化位置曲线跟随器
+ * @param follower
+ * @param config
+ */
+void SCurveTraj_PosAxis_Init(SCurveTrajFollower_PosAxis_t*             follower,
+                             const SCurveTrajFollower_PosAxisConfig_t* config)
+{
+    if (config->update_interval == 0)
+        return;
+
+    follower->ctrl = config->motor_pos_ctrl;
+
+    follower->update_interval = config->update_interval;
+    follower->v_max           = config->v_max;
+    follower->a_max           = config->a_max;
+    follower->j_max           = config->j_max;
+
+    follower->origin  = 0;
+    follower->now     = 0.0f;
+    follower->running = false;
+
+    PROFILE_RESET(&follower->profile);
+}
+
+/**
+ * 更新函数
+ * @note 更新顺序：
+ *      SCurveTraj_PosAxis_Update
+ *      Motor_PosCtrlUpdate
+ * @note 力矩前馈保持调用方设置的值不变
+ * @param follower
+ */
+void SCurveTraj_PosAxis_Update(SCurveTrajFollower_PosAxis_t* follower)
+{
+    if (!follower->running)
+        return;
+
+    PROFILE_BEGIN();
+    const float now = follower->now + follower->update_interval;
+    follower->now   = now;
+    // 曲线位置作为目标，在定点下叠加到起点上
+    const float      target = SCurve_CalcX(&follower->s, now);
+    const MotorPos_t origin = MotorPos_Load(&follower->origin);
+    Motor_PosCtrl_SetRefPos(follower->ctrl, MotorPos_AddDeg(origin, target));
+    // 曲线速度、加速度作为前馈
+    Motor_PosCtrl_SetFeedforward(follower->ctrl,
+                                 DPS2RPM(SCurve_CalcV(&follower->s, now)),
+                                 DPS2RPM(SCurve_CalcA(&follower->s, now)),
+                                 follower->ctrl->feedforward.torque);
+    PROFILE_END(&follower->profile);
+}
+
+/**
+ * 停止并清零所有
+ * @note 该函数执行包括：停止曲线，清除速度、加速度前馈，电机角度归零，位置目标置零
+ * @param follower
+ */
+void SCurveTraj_PosAxis_ResetAll(SCurveTrajFollower_PosAxis_t* follower)
+{
+    follower->running = false;
+    SCurve_Reset(&follower->s);
+    Motor_PosCtrl_SetFeedforward(follower->ctrl, 0, 0, follower->ctrl->feedforward.torque);
+    MotorCtrl_ResetAngle(follower->ctrl);
+    Motor_PosCtrl_SetRef(follower->ctrl, 0);
+    MotorPos_Store(&follower->origin, 0);
+}
+
+/**
+ * 停止曲线，位置环保持最后一次设置的目标
+ * @param follower
+ */
+void SCurveTraj_PosAxis_Stop(SCurveTrajFollower_PosAxis_t* follower)
+{
+    follower->running = false;
+    Motor_PosCtrl_SetFeedforward(follower->ctrl, 0, 0, follower->ctrl->feedforward.torque);
+}
+
+/**
+ * 以位置环当前目标为原点规划曲线
+ *
+ * 从当前目标而不是反馈位置出发，运行中重新规划时目标不会跳变
+ * @param distance 目标相对当前目标的位移 (unit: deg)
+ */
+static SCurve_Result_t pos_axis_s_curve_init(SCurve_t*                           s,
+                                             const SCurveTrajFollower_PosAxis_t* follower,
+                                             const bool                          running,
+                                             const float                         distance)
+{
+    return SCurve_Init(s,
+                       0,        // 从当前目标起始,
+                       distance, // 到目标位置
+                       running ? SCurve_CalcV(&follower->s, follower->now)
+                               : RPM2DPS(MotorCtrl_GetVelocity(follower->ctrl)), // 保证速度连续
+                       running ? SCurve_CalcA(&follower->s, follower->now)
+                               : 0, // 尽量保证加速度也连续,
+                       follower->v_max,
+                       follower->a_max,
+                       follower->j_max);
+}
+
+/**
+ * 以给定原点规划曲线并启动
+ */
+static SCurve_Result_t pos_axis_start(SCurveTrajFollower_PosAxis_t* follower,
+                                      const MotorPos_t              origin,
+                                      const float                   distance)
+{
+    const bool running = follower->running;
+
+    follower->running = false;
+
+    const SCurve_Result_t r = pos_axis_s_curve_init(&follower->s, follower, running, distance);
+
+    MotorPos_Store(&follower->origin, origin);
+    follower->now = 0;
+    if (r == S_CURVE_SUCCESS)
+        follower->running = true;
+    else
+        // 规划失败会破坏原有曲线结构，停止曲线，位置环保持当前目标
+        SCurveTraj_PosAxis_Stop(follower);
+
+    return r;
+}
+
+/**
+ * 设置目标位置
+ * @param follower
+ * @param target 目标角度
+ * @return 是否规划成功
+ */
+SCurve_Result_t SCurveTraj_PosAxis_SetTarget(SCurveTrajFollower_PosAxis_t* follower,
+                                             const float                   target)
+{
+    const MotorPos_t origin = MotorPos_Load(&follower->ctrl->target);
+    return pos_axis_start(follower, origin, MotorPos_DiffDeg(MotorPos_FromDeg(target), origin));
+}
+
+/**
+ * 设置相对目标位置
+ * @param follower
+ * @param delta_pos 相对当前目标的角度
+ * @return 是否规划成功
+ */
+SCurve_Result_t SCurveTraj_PosAxis_SetTargetRelPos(SCurveTrajFollower_PosAxis_t* follower,
+                                                   const float                   delta_pos)
+{
+    return pos_axis_start(follower, MotorPos_Load(&follower->ctrl->target), delta_pos);
+}
+
+/**
+ * 计算预计需要的时间
+ * @param follower
+ * @param target 目标角度
+ * @return 预计需要的时间
+ */
+float SCurveTraj_PosAxis_EstimateDuration(const SCurveTrajFollower_PosAxis_t* follower,
+                                          const float                         target)
+{
+    // 临时规划器
+    SCurve_t              temps;
+    const float           distance = MotorPos_DiffDeg(MotorPos_FromDeg(target),
+                                            MotorPos_Load(&follower->ctrl->target));
+    const SCurve_Result_t r = pos_axis_s_curve_init(&temps, follower, follower->running, distance);
     if (r != S_CURVE_SUCCESS)
         return -1.0f;
     return temps.total_time;
@@ -205,12 +393,14 @@ void SCurveTraj_Group_Init(SCurveTrajFollower_Group_t*             follower,
     follower->a_max           = config->a_max;
     follower->j_max           = config->j_max;
 
+    follower->origin  = 0;
     follower->now     = 0.0f;
     follower->running = false;
 
 #ifdef DEBUG
     follower->current_target = 0.0f;
 #endif
+    PROFILE_RESET(&follower->profile);
 }
 
 /**
@@ -225,26 +415,30 @@ void SCurveTraj_Group_Update(SCurveTrajFollower_Group_t* follower)
     if (!follower->running)
         return;
 
+    PROFILE_BEGIN();
     const float now = follower->now + follower->update_interval;
     follower->now   = now;
     // 计算速度前馈量
     const float ff_velocity = SCurve_CalcV(&follower->s, now);
     // 计算当前目标位置
-    const float target = SCurve_CalcX(&follower->s, now);
+    const float      target = SCurve_CalcX(&follower->s, now);
+    const MotorPos_t origin = MotorPos_Load(&follower->origin);
 #ifdef DEBUG
-    follower->current_target = target;
+    follower->current_target = MotorPos_ToDeg(MotorPos_AddDeg(origin, target));
 #endif
-    // 计算 PD 输出
+    // 计算 PD 输出，反馈为相对曲线起点的位移，在定点下相减
     for (size_t i = 0; i < follower->item_count; i++)
     {
+        const MotorPos_t pos      = MotorCtrl_GetPos(follower->items[i].ctrl);
         follower->items[i].pd.ref = target;
-        follower->items[i].pd.fdb = MotorCtrl_GetAngle(follower->items[i].ctrl);
+        follower->items[i].pd.fdb = MotorPos_DiffDeg(pos, origin);
         PD_Calculate(&follower->items[i].pd);
         // 计算总速度
         const float velocity = ff_velocity + follower->items[i].pd.output;
         // 设置电机速度
         Motor_VelCtrl_SetRef(follower->items[i].ctrl, DPS2RPM(velocity));
     }
+    PROFILE_END(&follower->profile);
 }
 
 /**
@@ -263,6 +457,7 @@ void SCurveTraj_Group_ResetAll(SCurveTrajFollower_Group_t* follower)
         Motor_VelCtrl_SetRef(follower->items[i].ctrl, 0);
         MotorCtrl_ResetAngle(follower->items[i].ctrl);
     }
+    MotorPos_Store(&follower->origin, 0);
 }
 void SCurveTraj_Group_Stop(SCurveTrajFollower_Group_t* follower)
 {
@@ -274,25 +469,43 @@ void SCurveTraj_Group_Stop(SCurveTrajFollower_Group_t* follower)
     }
 }
 
+/**
+ * 计算所有受控电机的平均位置
+ *
+ * 以第一个电机为基准在定点下累加偏差，避免直接累加绝对位置时溢出或损失精度
+ */
+static MotorPos_t group_get_mean_pos(const SCurveTrajFollower_Group_t* follower)
+{
+    const MotorPos_t base = MotorCtrl_GetPos(follower->items[0].ctrl);
+    MotorPos_t       sum  = 0;
+
+    for (size_t i = 1; i < follower->item_count; i++)
+        sum += MotorCtrl_GetPos(follower->items[i].ctrl) - base;
+
+    return base + sum / (MotorPos_t) follower->item_count;
+}
+
+/**
+ * 以平均位置为原点规划曲线
+ * @param distance 目标相对平均位置的位移 (unit: deg)
+ */
 static SCurve_Result_t group_s_curve_init(SCurve_t*                         s,
                                           const SCurveTrajFollower_Group_t* follower,
                                           const bool                        running,
-                                          const float                       target)
+                                          const float                       distance)
 {
-    float start_position = 0, start_velocity = 0;
+    float start_velocity = 0;
 
     for (size_t i = 0; i < follower->item_count; i++)
     {
-        // 以平均速度和平均位置作为起始点
-        start_position += MotorCtrl_GetAngle(follower->items[i].ctrl);
+        // 以平均速度作为起始速度
         start_velocity += MotorCtrl_GetVelocity(follower->items[i].ctrl);
     }
-    start_position /= (float) follower->item_count;
     start_velocity /= (float) follower->item_count;
 
     return SCurve_Init(s,
-                       start_position,
-                       target,         // 到目标位置
+                       0,
+                       distance,       // 到目标位置
                        start_velocity, // 保证速度连续
                        running ? SCurve_CalcA(&follower->s, follower->now)
                                : 0, // 尽量保证加速度也连续,
@@ -312,8 +525,12 @@ SCurve_Result_t SCurveTraj_Group_SetTarget(SCurveTrajFollower_Group_t* follower,
     const bool running = follower->running;
 
     follower->running       = false;
-    const SCurve_Result_t r = group_s_curve_init(&follower->s, follower, running, target);
+    const MotorPos_t origin   = group_get_mean_pos(follower);
+    const float      distance = MotorPos_DiffDeg(MotorPos_FromDeg(target), origin);
+
+    const SCurve_Result_t r = group_s_curve_init(&follower->s, follower, running, distance);
 
+    MotorPos_Store(&follower->origin, origin);
     follower->now = 0;
     if (r == S_CURVE_SUCCESS)
         follower->running = true;
@@ -339,18 +556,11 @@ SCurve_Result_t SCurveTraj_Group_SetTargetRelPos(SCurveTrajFollower_Group_t* fol
 
     follower->running = false;
 
-    float current_pos = 0;
-
-    for (size_t i = 0; i < follower->item_count; i++)
-    {
-        current_pos += MotorCtrl_GetAngle(follower->items[i].ctrl);
-    }
-
-    current_pos /= (float) follower->item_count;
+    const MotorPos_t origin = group_get_mean_pos(follower);
 
-    const SCurve_Result_t r =
-            group_s_curve_init(&follower->s, follower, running, current_pos + delta_pos);
+    const SCurve_Result_t r = group_s_curve_init(&follower->s, follower, running, delta_pos);
 
+    MotorPos_Store(&follower->origin, origin);
     follower->now = 0;
     if (r == S_CURVE_SUCCESS)
         follower->running = true;
@@ -374,7 +584,9 @@ float SCurveTraj_Group_EstimateDuration(const SCurveTrajFollower_Group_t* follow
 {
     // 临时规划器
     SCurve_t              temps;
-    const SCurve_Result_t r = group_s_curve_init(&temps, follower, follower->running, target);
+    const float           distance =
+            MotorPos_DiffDeg(MotorPos_FromDeg(target), group_get_mean_pos(follower));
+    const SCurve_Result_t r = group_s_curve_init(&temps, follower, follower->running, distance);
 
     if (r != S_CURVE_SUCCESS)
         return -1.0f;
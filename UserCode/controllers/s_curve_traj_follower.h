@@ -22,6 +22,12 @@ extern "C"
  */
 #define DPS2RPM(__DEG_PER_SEC__) ((__DEG_PER_SEC__) / 360.0f * 60.0f)
 
+/**
+ * rpm 转为 deg/s
+ * @param __RPM__ rpm
+ */
+#define RPM2DPS(__RPM__) ((__RPM__) * 360.0f / 60.0f)
+
 typedef struct
 {
     bool running;
@@ -34,11 +40,14 @@ typedef struct
     float            a_max; ///< 最大加速度
     float            j_max; ///< 最大加加速度
 
-    float now;
+    MotorPos_t origin; ///< 曲线起点 (定点)，曲线在相对该点的坐标下规划
+    float      now;
 
 #ifdef DEBUG
     float current_target; ///< 曲线当前目标位置
 #endif
+
+    PROFILE_FIELD(profile) ///< 更新耗时
 } SCurveTrajFollower_Axis_t;
 
 /**
@@ -56,6 +65,41 @@ typedef struct
     float            j_max;           ///< 最大加加速度
 } SCurveTrajFollower_AxisConfig_t;
 
+/**
+ * 单电机位置曲线跟随
+ *
+ * 每周期将曲线位置设为位置环目标，曲线速度、加速度作为位置环前馈，
+ * 误差由位置环修正，不需要额外的 PD
+ */
+typedef struct
+{
+    bool running;
+
+    float            update_interval; ///< 更新间隔
+    SCurve_t         s;
+    Motor_PosCtrl_t* ctrl;
+    float            v_max; ///< 最大速度
+    float            a_max; ///< 最大加速度
+    float            j_max; ///< 最大加加速度
+
+    MotorPos_t origin; ///< 曲线起点 (定点)，曲线在相对该点的坐标下规划
+    float      now;
+
+    PROFILE_FIELD(profile) ///< 更新耗时
+} SCurveTrajFollower_PosAxis_t;
+
+/**
+ * 单电机位置曲线跟随配置
+ */
+typedef struct
+{
+    float            update_interval; ///< 更新间隔 (s)
+    Motor_PosCtrl_t* motor_pos_ctrl;  ///< 电机控制对象
+    float            v_max;           ///< 最大速度
+    float            a_max;           ///< 最大加速度
+    float            j_max;           ///< 最大加加速度
+} SCurveTrajFollower_PosAxisConfig_t;
+
 typedef struct
 {
     Motor_VelCtrl_t* ctrl;
@@ -81,11 +125,14 @@ typedef struct
     SCurveTrajFollower_GroupItem_t* items;
     size_t                          item_count;
 
-    float now;
+    MotorPos_t origin; ///< 曲线起点 (定点)，为所有受控电机位置的平均值
+    float      now;
 
 #ifdef DEBUG
     float current_target; ///< 曲线当前目标位置
 #endif
+
+    PROFILE_FIELD(profile) ///< 更新耗时
 } SCurveTrajFollower_Group_t;
 
 /**
@@ -127,6 +174,21 @@ SCurve_Result_t SCurveTraj_Axis_SetTargetRelPos(SCurveTrajFollower_Axis_t* follo
 
 float SCurveTraj_Axis_EstimateDuration(const SCurveTrajFollower_Axis_t* follower, float target);
 
+void SCurveTraj_PosAxis_Init(SCurveTrajFollower_PosAxis_t*             follower,
+                             const SCurveTrajFollower_PosAxisConfig_t* config);
+
+void SCurveTraj_PosAxis_Update(SCurveTrajFollower_PosAxis_t* follower);
+
+void SCurveTraj_PosAxis_ResetAll(SCurveTrajFollower_PosAxis_t* follower);
+void SCurveTraj_PosAxis_Stop(SCurveTrajFollower_PosAxis_t* follower);
+
+SCurve_Result_t SCurveTraj_PosAxis_SetTarget(SCurveTrajFollower_PosAxis_t* follower, float target);
+SCurve_Result_t SCurveTraj_PosAxis_SetTargetRelPos(SCurveTrajFollower_PosAxis_t* follower,
+                                                   float                         delta_pos);
+
+float SCurveTraj_PosAxis_EstimateDuration(const SCurveTrajFollower_PosAxis_t* follower,
+                                          float                               target);
+
 void SCurveTraj_Group_Init(SCurveTrajFollower_Group_t*             follower,
                            const SCurveTrajFollower_GroupConfig_t* config);
 
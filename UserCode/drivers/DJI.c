@@ -52,6 +52,30 @@ static float reduction_rate_map[DJI_MOTOR_TYPE_COUNT] = {
     [M2006_C610] = (36.0f),
 };
 
+/**
+ * 电机减速比 map (分子 / 分母)，用于定点位置的精确换算
+ */
+static const struct
+{
+    uint32_t num;
+    uint32_t den;
+} reduction_ratio_map[DJI_MOTOR_TYPE_COUNT] = {
+    [M3508_C620] = { 3591, 187 },
+    [M2006_C610] = { 36, 1 },
+};
+
+/**
+ * 电流指令满量程 map
+ */
+static const struct
+{
+    float iq_per_amp; ///< 每安培对应的电流指令值
+    float iq_max;     ///< 电流指令最大值
+} iq_scale_map[DJI_MOTOR_TYPE_COUNT] = {
+    [M3508_C620] = { DJI_M3508_C620_IQ_MAX / DJI_M3508_C620_CURRENT_MAX, DJI_M3508_C620_IQ_MAX },
+    [M2006_C610] = { DJI_M2006_C610_IQ_MAX / DJI_M2006_C610_CURRENT_MAX, DJI_M2006_C610_IQ_MAX },
+};
+
 static inline DJI_t* getDJIHandle(DJI_t* motors[8], const CAN_RxHeaderTypeDef* header)
 {
     if (header->IDE != CAN_ID_STD)
@@ -83,6 +107,10 @@ void DJI_Init(DJI_t* hdji, const DJI_Config_t* dji_config)
                                ((dji_config->reduction_rate > 0 ? dji_config->reduction_rate
                                                                 : 1.0f)        // 外接减速比
                                 * reduction_rate_map[dji_config->motor_type]); // 电机内部减速比
+    hdji->pos_ratio          = MotorPos_RatioMul(
+            MotorPos_RatioFromFloat(dji_config->reduction_rate),
+            MotorPos_Ratio(reduction_ratio_map[dji_config->motor_type].num,
+                           reduction_ratio_map[dji_config->motor_type].den));
 
     hdji->feedback_snacks = 0;
 
@@ -137,6 +165,10 @@ void DJI_DataDecode(DJI_t* hdji, const uint8_t data[8])
                       ((float) hdji->feedback.round_cnt * 360.0f + hdji->feedback.mech_angle -
                        hdji->angle_zero) *
                       hdji->inv_reduction_rate;
+    const MotorPos_t abs_pos = MotorPos_FromRotor(hdji->feedback.round_cnt,
+                                                 hdji->feedback.mech_angle - hdji->angle_zero,
+                                                 hdji->pos_ratio);
+    MotorPos_Store(&hdji->abs_pos, hdji->reverse ? -abs_pos : abs_pos);
 
     hdji->feedback.rpm = feedback_rpm;
     hdji->velocity     = (hdji->reverse ? -1.0f : 1.0f) * // 反转时需要反转速度输入
@@ -159,6 +191,22 @@ void DJI_ResetAngle(DJI_t* hdji)
     hdji->feedback.round_cnt = 0;
     hdji->angle_zero         = hdji->feedback.mech_angle;
     hdji->abs_angle          = 0;
+    MotorPos_Store(&hdji->abs_pos, 0);
+}
+
+/**
+ * 按电流设置电流指令（不发送）
+ * @param hdji DJI handle
+ * @param current 电流 (unit: A)，超出电调量程时限幅
+ */
+void DJI_SetCurrent(DJI_t* hdji, const float current)
+{
+    const float iq_max = iq_scale_map[hdji->motor_type].iq_max;
+
+    float iq = current * iq_scale_map[hdji->motor_type].iq_per_amp;
+    iq       = iq > iq_max ? iq_max : iq;
+    iq       = iq < -iq_max ? -iq_max : iq;
+    __DJI_SET_IQ_CMD(hdji, iq);
 }
 
 /**
@@ -270,7 +318,11 @@ void DJI_CAN_BaseReceiveCallback(const CAN_HandleTypeDef*   hcan,
         {
             DJI_t* hdji = getDJIHandle(map[i].motors, header);
             if (hdji != NULL)
+            {
+                PROFILE_BEGIN();
                 DJI_DataDecode(hdji, data);
+                PROFILE_END(&hdji->decode_profile);
+            }
             return;
         }
     }
@@ -46,8 +46,13 @@ extern "C"
 #define DJI_M2006_C610_IQ_MAX (10000)
 #define DJI_M3508_C620_IQ_MAX (16384)
 
+#define DJI_M2006_C610_CURRENT_MAX (10.0f) ///< IQ_MAX 对应的电流 (unit: A)
+#define DJI_M3508_C620_CURRENT_MAX (20.0f) ///< IQ_MAX 对应的电流 (unit: A)
+
 #include <stdbool.h>
 #include "main.h"
+#include "bsp/cycle_profiler.h"
+#include "bsp/motor_pos.h"
 
 typedef enum
 {
@@ -74,7 +79,8 @@ typedef struct
     uint8_t         id1;        //< 电调 ID (1 ~ 8)
     float           angle_zero; //< 零点角度 (unit: degree)
 
-    float inv_reduction_rate; ///< 减速比
+    float            inv_reduction_rate; ///< 减速比
+    MotorPos_Ratio_t pos_ratio;          ///< 减速比 (整数分子分母)，用于定点位置
 
     /* Feedback */
     uint32_t feedback_snacks; ///< 每次发送控制指令 feed--, 接收到控制指令 feed = 10
@@ -90,11 +96,14 @@ typedef struct
     } feedback;
 
     /* Data */
-    float abs_angle; //< 电机轴输出角度 (unit: degree)
-    float velocity;  //< 电机轴输出速度 (unit: rpm)
+    float      abs_angle; //< 电机轴输出角度 (unit: degree)
+    MotorPos_t abs_pos;   ///< 电机轴输出位置 (定点)
+    float      velocity;  //< 电机轴输出速度 (unit: rpm)
 
     /* Output */
     uint16_t iq_cmd; //< 电流指令值
+
+    PROFILE_FIELD(decode_profile) ///< 反馈解码耗时
 } DJI_t;
 
 typedef struct
@@ -123,8 +132,10 @@ typedef struct
 
 #define __DJI_GET_ANGLE(__DJI_HANDLE__)    (((DJI_t*) (__DJI_HANDLE__))->abs_angle)
 #define __DJI_GET_VELOCITY(__DJI_HANDLE__) (((DJI_t*) (__DJI_HANDLE__))->velocity)
+#define __DJI_GET_POS(__DJI_HANDLE__)      MotorPos_Load(&((DJI_t*) (__DJI_HANDLE__))->abs_pos)
 
 void DJI_ResetAngle(DJI_t* hdji);
+void DJI_SetCurrent(DJI_t* hdji, float current);
 void DJI_Init(DJI_t* hdji, const DJI_Config_t* dji_config);
 void DJI_CAN_FilterInit(CAN_HandleTypeDef* hcan, uint32_t filter_bank);
 
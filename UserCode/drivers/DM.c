@@ -14,6 +14,17 @@ static float reduction_rate_map[DM_MOTOR_TYPE_COUNT] = {
     [DM_S3519] = (19.203f),
 };
 
+/**
+ * 电机减速比 map (分子 / 分母)，用于定点位置的精确换算
+ */
+static const struct
+{
+    uint32_t num;
+    uint32_t den;
+} reduction_ratio_map[DM_MOTOR_TYPE_COUNT] = {
+    [DM_S3519] = { 19203, 1000 },
+};
+
 static inline DM_t* getDMHandle(DM_t*                      motors[8],
                                 const uint8_t*             data,
                                 const CAN_RxHeaderTypeDef* header)
@@ -81,6 +92,10 @@ void DM_Init(DM_t* hdm, const DM_Config_t* dm_config)
                               ((dm_config->reduction_rate > 0 ? dm_config->reduction_rate
                                                               : 1.0f)        // 外接减速比
                                * reduction_rate_map[dm_config->motor_type]); // 电机内部减速比
+    hdm->pos_ratio          = MotorPos_RatioMul(
+            MotorPos_RatioFromFloat(dm_config->reduction_rate),
+            MotorPos_Ratio(reduction_ratio_map[dm_config->motor_type].num,
+                           reduction_ratio_map[dm_config->motor_type].den));
     /* 注册回调 */
     DM_t** mapped_motors = NULL;
     for (int i = 0; i < map_size; i++)
@@ -151,6 +166,9 @@ void DM_DataDecode(DM_t* hdm, const uint8_t data[8])
     hdm->abs_angle = (hdm->reverse ? -1.0f : 1.0f) * // 反转时需要反转角度输入
                      ((float) hdm->round_cnt * 360.0f + angle - hdm->angle_zero) *
                      hdm->inv_reduction_rate;
+    const MotorPos_t abs_pos =
+            MotorPos_FromRotor(hdm->round_cnt, angle - hdm->angle_zero, hdm->pos_ratio);
+    MotorPos_Store(&hdm->abs_pos, hdm->reverse ? -abs_pos : abs_pos);
     hdm->vel = (hdm->reverse ? -1.0f : 1.0f) * vel;
     hdm->feedback_count++;
 
@@ -170,6 +188,7 @@ void DM_ResetAngle(DM_t* hdm)
     hdm->round_cnt  = 0;
     hdm->angle_zero = hdm->feedback.angle;
     hdm->abs_angle  = 0;
+    MotorPos_Store(&hdm->abs_pos, 0);
 }
 
 static void dm_vel_set_command_data(DM_t* hdm, const float value_vel, uint8_t data[])
@@ -230,6 +249,49 @@ void DM_Pos_SendSetCmd(DM_t* hdm, const float value_pos)
                     data);
 }
 
+/**
+ * 将浮点数线性映射到无符号整数
+ */
+static uint16_t float_to_uint(const float x, const float x_min, const float x_max, const int bits)
+{
+    const float span = x_max - x_min;
+    const float v    = x < x_min ? x_min : (x > x_max ? x_max : x);
+    return (uint16_t) ((v - x_min) * (float) ((1 << bits) - 1) / span);
+}
+
+/**
+ * MIT 模式力矩指令
+ *
+ * Kp, Kd 均为 0，电机只执行前馈力矩
+ * @attention 电机需以 DM_MODE_MIT 模式初始化
+ * @param hdm DM handle
+ * @param torque 力矩 (unit: N·m)，超出 T_MAX 时限幅
+ */
+void DM_MIT_SendTorqueCmd(DM_t* hdm, const float torque)
+{
+    uint8_t        data[8];
+    const uint16_t p = float_to_uint(0.0f, -hdm->POS_MAX_RAD, hdm->POS_MAX_RAD, 16);
+    const uint16_t v = float_to_uint(0.0f, -hdm->VEL_MAX_RAD, hdm->VEL_MAX_RAD, 12);
+    const uint16_t t = float_to_uint(hdm->reverse ? -torque : torque, -hdm->T_MAX, hdm->T_MAX, 12);
+
+    data[0] = p >> 8;
+    data[1] = p & 0xFF;
+    data[2] = v >> 4;
+    data[3] = (v & 0x0F) << 4; // Kp 高 4 位为 0
+    data[4] = 0;               // Kp 低 8 位
+    data[5] = 0;               // Kd 高 8 位
+    data[6] = t >> 8;          // Kd 低 4 位为 0
+    data[7] = t & 0xFF;
+    CAN_SendMessage(hdm->hcan,
+                    &(CAN_TxHeaderTypeDef) {
+                            .StdId = DM_MODE_MIT | hdm->id0,
+                            .IDE   = CAN_ID_STD,
+                            .RTR   = CAN_RTR_DATA,
+                            .DLC   = 8,
+                    },
+                    data);
+}
+
 /**
  * @brief 错误处理
  *
@@ -292,7 +354,11 @@ void DM_CAN_BaseReceiveCallback(const CAN_HandleTypeDef*   hcan,
         {
             DM_t* hdm = getDMHandle(map[i].motors, data, header);
             if (hdm != NULL)
+            {
+                PROFILE_BEGIN();
                 DM_DataDecode(hdm, data);
+                PROFILE_END(&hdm->decode_profile);
+            }
             return;
         }
     }
@@ -3,6 +3,8 @@
 
 #include "main.h"
 #include "stdbool.h"
+#include "bsp/cycle_profiler.h"
+#include "bsp/motor_pos.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -55,10 +57,14 @@ typedef struct
     float     T_MAX;
     DM_MODE_T mode;
 
-    float          abs_angle;          //< 电机轴输出角度 (unit: degree)
-    float          vel;                // 电机轴输出速度 (unit: rpm)
-    DM_MotorType_t motor_type;         //< 电机类型
-    float          inv_reduction_rate; ///< 减速比
+    float            abs_angle;          //< 电机轴输出角度 (unit: degree)
+    MotorPos_t       abs_pos;            ///< 电机轴输出位置 (定点)
+    float            vel;                // 电机轴输出速度 (unit: rpm)
+    DM_MotorType_t   motor_type;         //< 电机类型
+    float            inv_reduction_rate; ///< 减速比
+    MotorPos_Ratio_t pos_ratio;          ///< 减速比 (整数分子分母)，用于定点位置
+
+    PROFILE_FIELD(decode_profile) ///< 反馈解码耗时
 } DM_t;
 
 typedef struct
@@ -83,6 +89,7 @@ typedef struct
 
 #define __DM_GET_ANGLE(__DM_HANDLE__)    (((DM_t*) (__DM_HANDLE__))->abs_angle)
 #define __DM_GET_VELOCITY(__DM_HANDLE__) (((DM_t*) (__DM_HANDLE__))->vel)
+#define __DM_GET_POS(__DM_HANDLE__)      MotorPos_Load(&((DM_t*) (__DM_HANDLE__))->abs_pos)
 
 void DM_ERROR_HANDLER();
 void DM_CAN_FilterInit(CAN_HandleTypeDef* hcan, const uint32_t filter_bank);
@@ -95,6 +102,7 @@ void DM_CAN_BaseReceiveCallback(const CAN_HandleTypeDef*   hcan,
                                 const uint8_t              data[]);
 void DM_Vel_SendSetCmd(DM_t* hdm, const float value_vel);
 void DM_Pos_SendSetCmd(DM_t* hdm, const float value_pos);
+void DM_MIT_SendTorqueCmd(DM_t* hdm, float torque);
 void DM_ResetAngle(DM_t* hdm);
 
 #ifdef __cplusplus
@@ -29,26 +29,78 @@ extern "C"
 {
 #endif
 
+/**
+ * 各状态下 IN1/IN2 的电平，bit0: IN1, bit1: IN2
+ */
+static const uint8_t pin_levels[] = {
+    [TB6612_PIN_STATE_FORWARD] = 0x2U,
+    [TB6612_PIN_STATE_REVERSE] = 0x1U,
+    [TB6612_PIN_STATE_BRAKE]   = 0x3U,
+    [TB6612_PIN_STATE_COAST]   = 0x0U,
+};
+
+/**
+ * 计算单个引脚的 BSRR 写入值
+ */
+static inline uint32_t pin_bsrr(const uint16_t pin, const bool high)
+{
+    return high ? pin : (uint32_t) pin << 16U;
+}
+
+/**
+ * 切换 IN1/IN2 状态
+ * @param hmotor handle
+ * @param state 目标状态
+ */
+static void set_pin_state(TB6612_t* hmotor, const TB6612_PinState_t state)
+{
+    hmotor->pin_state = state;
+
+    const uint32_t in1 = pin_bsrr(hmotor->in1.pin, pin_levels[state] & 0x1U);
+    const uint32_t in2 = pin_bsrr(hmotor->in2.pin, pin_levels[state] & 0x2U);
+    if (hmotor->in1.port == hmotor->in2.port)
+    {
+        // 同一端口，一次 BSRR 写入同时完成置位和复位
+        hmotor->in1.port->BSRR = in1 | in2;
+    }
+    else
+    {
+        hmotor->in1.port->BSRR = in1;
+        hmotor->in2.port->BSRR = in2;
+    }
+}
+
 /**
  * 设置速度
+ * @note 仅在 IN1/IN2 状态改变时写引脚，占空比通过缓存的 ARR 直接写入 CCR
+ * @note 占空比绝对值不大于 deadband 时按 stop_mode 停止，否则映射到 [friction_duty, 1]
  * @param hmotor handle
  * @param speed 速度 [-1, 1]
  */
 void TB6612_SetSpeed(TB6612_t* hmotor, float speed)
 {
+    hmotor->duty_cmd = speed;
     speed *= hmotor->output_reverse ? -1.0f : 1.0f;
-    if (speed >= 0)
+
+    float             duty = speed >= 0 ? speed : -speed;
+    TB6612_PinState_t state;
+    if (duty <= hmotor->deadband)
     {
-        HAL_GPIO_WritePin(hmotor->in1.port, hmotor->in1.pin, GPIO_PIN_RESET);
-        HAL_GPIO_WritePin(hmotor->in2.port, hmotor->in2.pin, GPIO_PIN_SET);
-        PWM_SetDutyCircle(&hmotor->pwm, speed);
+        state = hmotor->stop_mode == TB6612_STOP_COAST ? TB6612_PIN_STATE_COAST
+                                                       : TB6612_PIN_STATE_BRAKE;
+        // 制动时 PWM 输出低，滑行时 PWM 输出高 (IN1 = IN2 = L, PWM = H 为高阻)
+        duty = state == TB6612_PIN_STATE_COAST ? 1.0f : 0.0f;
     }
     else
     {
-        HAL_GPIO_WritePin(hmotor->in1.port, hmotor->in1.pin, GPIO_PIN_SET);
-        HAL_GPIO_WritePin(hmotor->in2.port, hmotor->in2.pin, GPIO_PIN_RESET);
-        PWM_SetDutyCircle(&hmotor->pwm, -speed);
+        state = speed >= 0 ? TB6612_PIN_STATE_FORWARD : TB6612_PIN_STATE_REVERSE;
+        duty  = hmotor->friction_duty + (1.0f - hmotor->friction_duty) * duty;
     }
+
+    if (state != hmotor->pin_state)
+        set_pin_state(hmotor, state);
+
+    PWM_SetDutyCircle(&hmotor->pwm, duty);
 }
 
 /**
@@ -58,7 +110,15 @@ void TB6612_SetSpeed(TB6612_t* hmotor, float speed)
 void TB6612_Enable(TB6612_t* hmotor)
 {
     HAL_TIM_Encoder_Start(hmotor->encoder, TIM_CHANNEL_ALL);
-    HAL_TIM_PWM_Start(hmotor->pwm.htim, hmotor->pwm.channel);
+    // 计数器自由运行，使能时以当前计数值作为基准
+    hmotor->last_counter = __HAL_TIM_GET_COUNTER(hmotor->encoder);
+    if (hmotor->mt.capture != NULL)
+    {
+        hmotor->mt.valid = false;
+        __HAL_TIM_CLEAR_FLAG(hmotor->mt.capture, hmotor->mt.flag);
+        HAL_TIM_IC_Start(hmotor->mt.capture, hmotor->mt.channel);
+    }
+    PWM_Start(&hmotor->pwm);
     TB6612_SetSpeed(hmotor, 0);
     hmotor->enable = true;
 }
@@ -70,11 +130,100 @@ void TB6612_Enable(TB6612_t* hmotor)
 void TB6612_Disable(TB6612_t* hmotor)
 {
     HAL_TIM_Encoder_Stop(hmotor->encoder, TIM_CHANNEL_ALL);
-    HAL_TIM_PWM_Stop(hmotor->pwm.htim, hmotor->pwm.channel);
+    if (hmotor->mt.capture != NULL)
+        HAL_TIM_IC_Stop(hmotor->mt.capture, hmotor->mt.channel);
+    PWM_Stop(&hmotor->pwm);
     TB6612_SetSpeed(hmotor, 0);
     hmotor->enable = false;
 }
 
+#ifndef TB6612_VEL_FILTER_DISABLE
+/**
+ * 转速滤波 / 观测
+ * @param hmotor handle
+ */
+static void velocity_filter_update(TB6612_t* hmotor)
+{
+    const float raw = hmotor->velocity_raw;
+    switch (hmotor->vf.type)
+    {
+    case TB6612_VEL_FILTER_IIR:
+        // 一阶低通 v += alpha * (raw - v)
+        hmotor->velocity += hmotor->vf.iir.alpha * (raw - hmotor->velocity);
+        break;
+    case TB6612_VEL_FILTER_MA:
+        // 滑动平均，缓冲区写满一轮后重新求和，消除累加误差
+        hmotor->vf.ma.sum += raw - hmotor->vf.ma.buffer[hmotor->vf.ma.index];
+        hmotor->vf.ma.buffer[hmotor->vf.ma.index] = raw;
+        if (++hmotor->vf.ma.index >= hmotor->vf.ma.size)
+        {
+            hmotor->vf.ma.index = 0;
+            hmotor->vf.ma.sum   = 0.0f;
+            for (uint8_t i = 0; i < hmotor->vf.ma.size; i++)
+                hmotor->vf.ma.sum += hmotor->vf.ma.buffer[i];
+        }
+        hmotor->velocity = hmotor->vf.ma.sum * hmotor->vf.ma.inv_size;
+        break;
+    case TB6612_VEL_FILTER_OBSERVER:
+    {
+        /**
+         * 以一阶直流电机模型 dω/dt = (gain * duty - ω) / tau 预测，
+         * 再用位置误差修正角度和转速估计
+         */
+        const float u = hmotor->duty_cmd;
+        hmotor->vf.obs.angle += hmotor->vf.obs.velocity * hmotor->vf.obs.rpm_to_deg;
+        hmotor->vf.obs.velocity +=
+                hmotor->vf.obs.k_model * (hmotor->vf.obs.gain * u - hmotor->vf.obs.velocity);
+        const float error = hmotor->angle - hmotor->vf.obs.angle;
+        hmotor->vf.obs.angle += hmotor->vf.obs.l1 * error;
+        hmotor->vf.obs.velocity += hmotor->vf.obs.l2 * error;
+        hmotor->velocity = hmotor->vf.obs.velocity;
+        break;
+    }
+    default:
+        hmotor->velocity = raw;
+        break;
+    }
+}
+#endif
+
+/**
+ * 初始化转速滤波器
+ * @param hmotor handle
+ * @param config 滤波器配置
+ */
+static void velocity_filter_init(TB6612_t* hmotor, const TB6612_VelFilterConfig_t* config)
+{
+#ifdef TB6612_VEL_FILTER_DISABLE
+    (void) config;
+    hmotor->vf.type = TB6612_VEL_FILTER_NONE;
+#else
+    hmotor->vf.type = config->type;
+    switch (config->type)
+    {
+    case TB6612_VEL_FILTER_IIR:
+        hmotor->vf.iir.alpha = config->alpha > 0 && config->alpha <= 1.0f ? config->alpha : 1.0f;
+        break;
+    case TB6612_VEL_FILTER_MA:
+        hmotor->vf.ma.size = config->ma_size > 0 && config->ma_size <= TB6612_VEL_MA_SIZE_MAX
+                                     ? config->ma_size
+                                     : TB6612_VEL_MA_SIZE_MAX;
+        hmotor->vf.ma.inv_size = 1.0f / (float) hmotor->vf.ma.size;
+        break;
+    case TB6612_VEL_FILTER_OBSERVER:
+        hmotor->vf.obs.k_model    = config->tau > 0 ? hmotor->sampling_period / config->tau : 0.0f;
+        hmotor->vf.obs.gain       = config->gain;
+        hmotor->vf.obs.l1         = config->l1;
+        hmotor->vf.obs.l2         = config->l2;
+        hmotor->vf.obs.rpm_to_deg = hmotor->sampling_period * 6.0f; // rpm -> deg / 采样周期
+        break;
+    default:
+        hmotor->vf.type = TB6612_VEL_FILTER_NONE;
+        break;
+    }
+#endif
+}
+
 /**
  * 初始化电机
  * @param hmotor handle
@@ -95,29 +244,362 @@ void TB6612_Init(TB6612_t* hmotor, const TB6612_Config_t* config)
     hmotor->in1.pin          = config->in1.pin;
     hmotor->in2.port         = config->in2.port;
     hmotor->in2.pin          = config->in2.pin;
+    hmotor->pin_state        = TB6612_PIN_STATE_NONE;
+    hmotor->stop_mode        = config->stop_mode;
+    hmotor->deadband         = config->deadband > 0 ? config->deadband : 0.0f;
+    hmotor->friction_duty    = config->friction_duty > 0 ? config->friction_duty : 0.0f;
     hmotor->pwm.htim         = config->pwm.htim;
     hmotor->pwm.channel      = config->pwm.channel;
     hmotor->sampling_period  = config->sampling_period;
     hmotor->roto_radio       = config->roto_radio;
     hmotor->reduction_radio  = config->reduction_radio;
+
+    // 缓存 PWM 的 ARR 和 CCR 地址
+    PWM_Init(&hmotor->pwm);
+
+    velocity_filter_init(hmotor, &config->velocity_filter);
+
+    /**
+     * 计数器不再清零，增量按计数器位宽取模计算
+     * 编码器定时器的 ARR 必须为计数器最大值 (0xFFFF 或 0xFFFFFFFF)
+     */
+    hmotor->counter_32bit = __HAL_TIM_GET_AUTORELOAD(config->encoder) > 0xFFFFU;
+    hmotor->last_counter  = __HAL_TIM_GET_COUNTER(config->encoder);
+    // 取倒数将除法转为乘法加快运算速度
+    hmotor->deg_per_tick = 360.0f / ((float) config->roto_radio * config->reduction_radio);
+    hmotor->pos_ratio    = MotorPos_RatioMul(MotorPos_Ratio(config->roto_radio, 1),
+                                         MotorPos_RatioFromFloat(config->reduction_radio));
+    hmotor->rpm_per_tick = hmotor->deg_per_tick / config->sampling_period / 360.0f * 60.0f;
+
+    if (config->capture != NULL && config->capture_freq > 0)
+    {
+        hmotor->mt.capture       = config->capture;
+        hmotor->mt.channel       = config->capture_channel;
+        hmotor->mt.flag          = TIM_FLAG_CC1 << (config->capture_channel >> 2U);
+        hmotor->mt.counter_32bit = __HAL_TIM_GET_AUTORELOAD(config->capture) > 0xFFFFU;
+        hmotor->mt.rpm_factor    = hmotor->deg_per_tick * config->capture_freq / 360.0f * 60.0f;
+        // 捕获定时器半个计数范围内必须出现边沿，否则间隔无法分辨
+        hmotor->mt.idle_max = (uint32_t) ((hmotor->mt.counter_32bit ? 2147483648.0f : 32768.0f) /
+                                          config->capture_freq / config->sampling_period);
+        // 半个计数范围不足一个采样周期时，至少允许一个采样周期没有边沿
+        if (hmotor->mt.idle_max == 0)
+            hmotor->mt.idle_max = 1;
+    }
+}
+
+/**
+ * M/T 法测速
+ *
+ * 用相邻两个采样周期内最后一个编码器边沿的时间差作为测速间隔，低速下仍然有较高的分辨率；
+ * 采样周期内没有边沿时，转速不会超过“一个计数 / 距上一次边沿的时间”
+ * @param hmotor handle
+ * @param edge 本采样周期内是否出现边沿
+ * @param edge_time 最后一个边沿的捕获值
+ */
+static void mt_velocity_update(TB6612_t* hmotor, const bool edge, const uint32_t edge_time)
+{
+    if (edge)
+    {
+        const int64_t  dn = hmotor->ticks - hmotor->mt.last_edge_ticks;
+        const uint32_t dt = hmotor->mt.counter_32bit
+                                    ? edge_time - hmotor->mt.last_edge_time
+                                    : (uint16_t) (edge_time - hmotor->mt.last_edge_time);
+        if (hmotor->mt.valid && dt != 0)
+            hmotor->velocity_raw = (float) dn * hmotor->mt.rpm_factor / (float) dt;
+
+        hmotor->mt.valid           = true;
+        hmotor->mt.last_edge_time  = edge_time;
+        hmotor->mt.last_edge_ticks = hmotor->ticks;
+        hmotor->mt.idle_samples    = 0;
+        return;
+    }
+
+    if (++hmotor->mt.idle_samples >= hmotor->mt.idle_max)
+    {
+        // 太久没有边沿，视为停转
+        hmotor->mt.valid        = false;
+        hmotor->mt.idle_samples = hmotor->mt.idle_max;
+        hmotor->velocity_raw    = 0.0f;
+        return;
+    }
+    if (!hmotor->mt.valid)
+        return;
+
+    const uint32_t now     = __HAL_TIM_GET_COUNTER(hmotor->mt.capture);
+    const uint32_t elapsed = hmotor->mt.counter_32bit
+                                     ? now - hmotor->mt.last_edge_time
+                                     : (uint16_t) (now - hmotor->mt.last_edge_time);
+    if (elapsed == 0)
+        return;
+    const float bound = hmotor->mt.rpm_factor / (float) elapsed;
+    if (hmotor->velocity_raw > bound)
+        hmotor->velocity_raw = bound;
+    else if (hmotor->velocity_raw < -bound)
+        hmotor->velocity_raw = -bound;
+}
+
+/**
+ * 读取 M/T 法捕获的最后一个边沿
+ * @param hmotor handle
+ * @param edge_time 最后一个边沿的捕获值
+ * @return 上次读取后是否出现边沿
+ */
+static bool mt_read_edge(TB6612_t* hmotor, uint32_t* edge_time)
+{
+    if (hmotor->mt.capture == NULL || !__HAL_TIM_GET_FLAG(hmotor->mt.capture, hmotor->mt.flag))
+        return false;
+    // 先清标志再读捕获值，之后的边沿会在下一个采样周期被处理
+    __HAL_TIM_CLEAR_FLAG(hmotor->mt.capture, hmotor->mt.flag);
+    *edge_time = HAL_TIM_ReadCapturedValue(hmotor->mt.capture, hmotor->mt.channel);
+    return true;
+}
+
+/**
+ * 由计数值更新角度和转速
+ * @param hmotor handle
+ * @param counter 编码器计数值
+ * @param mt 是否使用 M/T 法测速，否则按计数差分计算
+ * @param edge 本采样周期内是否出现边沿 (M/T 法)
+ * @param edge_time 最后一个边沿的捕获值 (M/T 法)
+ */
+static void counter_decode(TB6612_t*      hmotor,
+                           const uint32_t counter,
+                           const bool     mt,
+                           const bool     edge,
+                           const uint32_t edge_time)
+{
+    /* 按计数器位宽取模计算增量 */
+    int32_t delta = hmotor->counter_32bit ? (int32_t) (counter - hmotor->last_counter)
+                                          : (int16_t) (uint16_t) (counter - hmotor->last_counter);
+    hmotor->last_counter = counter;
+
+    if (hmotor->feedback_reverse)
+        delta = -delta;
+
+    hmotor->ticks += delta;
+
+    hmotor->angle = (float) hmotor->ticks * hmotor->deg_per_tick;
+    MotorPos_Store(&hmotor->pos, MotorPos_FromCount(hmotor->ticks, hmotor->pos_ratio));
+    if (mt)
+        mt_velocity_update(hmotor, edge, edge_time);
+    else
+        hmotor->velocity_raw = (float) delta * hmotor->rpm_per_tick; // 实际转速 (unit: rpm)
+
+#ifndef TB6612_VEL_FILTER_DISABLE
+    if (hmotor->vf.type != TB6612_VEL_FILTER_NONE)
+    {
+        velocity_filter_update(hmotor);
+        return;
+    }
+#endif
+    hmotor->velocity = hmotor->velocity_raw;
 }
 
 /**
  * 电机编码器数据解算
  * @note 本函数应当放置在周期为 hmotor->sampling_period 的定时器回调中调用
+ * @note 计数器自由运行，不再读后清零，避免读写之间的计数丢失；
+ *       单个采样周期内的计数变化不能超过计数器范围的一半
+ * @note 配置了捕获定时器时，转速由 M/T 法计算
  * @param hmotor handle
  */
 void TB6612_Encoder_DataDecode(TB6612_t* hmotor)
 {
-    /* @note: 假定转速不会快到数值溢出 */
-    const int16_t counter = __HAL_TIM_GET_COUNTER(hmotor->encoder);
-    /* 计算间隔内旋转的角度 */
-    const float delta = (hmotor->feedback_reverse ? -1.0f : 1.0f) * (float) counter /
-                        ((float) hmotor->roto_radio * hmotor->reduction_radio) * 360.0f;
-    hmotor->angle += delta;
-    hmotor->velocity = delta / hmotor->sampling_period / 360.0f * 60.0f; // 实际转速 (unit: rpm)
-    /* 清零计数 */
-    __HAL_TIM_SET_COUNTER(hmotor->encoder, 0);
+    PROFILE_BEGIN();
+    uint32_t edge_time = 0;
+    bool     edge      = mt_read_edge(hmotor, &edge_time);
+    uint32_t counter   = __HAL_TIM_GET_COUNTER(hmotor->encoder);
+    /**
+     * 读取捕获值和计数值之间出现的边沿已经计入 counter，却不在 edge_time 中，
+     * 此时重新读取一次，使最后一个边沿与计数值对应；
+     * 重读期间再次出现边沿只可能发生在高速下，此时一个计数的误差可以忽略
+     */
+    if (mt_read_edge(hmotor, &edge_time))
+    {
+        edge    = true;
+        counter = __HAL_TIM_GET_COUNTER(hmotor->encoder);
+    }
+    counter_decode(hmotor, counter, hmotor->mt.capture != NULL, edge, edge_time);
+    PROFILE_END(&hmotor->decode_profile);
+}
+
+/**
+ * 清零输出轴角度
+ * @param hmotor handle
+ */
+void TB6612_ResetAngle(TB6612_t* hmotor)
+{
+    hmotor->mt.last_edge_ticks -= hmotor->ticks; // 保持 M/T 法的计数基准连续
+#ifndef TB6612_VEL_FILTER_DISABLE
+    if (hmotor->vf.type == TB6612_VEL_FILTER_OBSERVER)
+        hmotor->vf.obs.angle -= hmotor->angle; // 保持观测器的角度估计连续
+#endif
+    hmotor->ticks = 0;
+    hmotor->angle = 0.0f;
+    MotorPos_Store(&hmotor->pos, 0);
+}
+
+/**
+ * 初始化同步更新组
+ * @note 会开启组内所有 PWM 通道的 CCR 预装载以及 ARR 预装载
+ * @param group 组
+ * @param motors 组内电机，需保证在组的生命周期内有效
+ * @param count 电机数量
+ * @param force_update 提交时是否立即产生更新事件
+ */
+void TB6612_Group_Init(TB6612_Group_t* group,
+                       TB6612_t*       motors[],
+                       const size_t    count,
+                       const bool      force_update)
+{
+    group->motors       = motors;
+    group->count        = count;
+    group->force_update = force_update;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        TIM_HandleTypeDef* htim = motors[i]->pwm.htim;
+        __HAL_TIM_ENABLE_OCxPRELOAD(htim, motors[i]->pwm.channel);
+        htim->Instance->CR1 |= TIM_CR1_ARPE;
+    }
+}
+
+/**
+ * 定时器的更新事件是否可以被暂停
+ *
+ * 开启了更新中断 / 更新 DMA 请求，或以更新事件作为 TRGO 时，该定时器的更新事件还被其他功能使用
+ * (如控制节拍、编码器采样触发、从定时器 / ADC 触发)，暂停会丢失这些事件
+ * @param tim 定时器
+ */
+static inline bool update_gatable(const TIM_TypeDef* tim)
+{
+    return !(tim->DIER & (TIM_DIER_UIE | TIM_DIER_UDE)) &&
+           (tim->CR2 & TIM_CR2_MMS) != TIM_TRGO_UPDATE;
+}
+
+/**
+ * 开始写入组内占空比
+ *
+ * 对没有共用更新事件的定时器置位 UDIS 暂停更新事件，此后写入的 CCR 只进入预装载寄存器，
+ * 直到 TB6612_Group_Commit 才一起锁存
+ * @note 开启了更新中断 / 更新 DMA 或以更新事件作为 TRGO 的定时器不会被暂停，
+ *       其上的通道由自然产生的更新事件锁存，若更新事件恰好发生在两次写入之间，
+ *       这些通道中的部分会晚一个 PWM 周期生效
+ * @param group 组
+ */
+void TB6612_Group_Begin(const TB6612_Group_t* group)
+{
+    for (size_t i = 0; i < group->count; i++)
+    {
+        TIM_TypeDef* tim = group->motors[i]->pwm.htim->Instance;
+        if (update_gatable(tim))
+            tim->CR1 |= TIM_CR1_UDIS;
+    }
+}
+
+/**
+ * 提交组内占空比
+ *
+ * 恢复更新事件，所有占空比在下一个更新事件同时生效；
+ * force_update 时立即产生一次更新事件 (同一定时器只产生一次)
+ * @attention force_update 会重置计数器并触发该定时器的更新中断和 DMA 请求，
+ *            定时器上挂有控制节拍或编码器采样触发时不要开启
+ * @note IN1/IN2 的方向切换不受预装载影响，会在 TB6612_SetSpeed 中立即生效
+ * @param group 组
+ */
+void TB6612_Group_Commit(const TB6612_Group_t* group)
+{
+    for (size_t i = 0; i < group->count; i++)
+    {
+        TIM_TypeDef* tim       = group->motors[i]->pwm.htim->Instance;
+        bool         committed = false;
+        for (size_t j = 0; j < i && !committed; j++)
+            committed = group->motors[j]->pwm.htim->Instance == tim; // 同一定时器已经提交过
+        if (committed)
+            continue;
+        tim->CR1 &= ~TIM_CR1_UDIS;
+        if (group->force_update)
+            tim->EGR = TIM_EGR_UG;
+    }
+}
+
+/**
+ * 同步设置组内所有电机的速度
+ * @param group 组
+ * @param speeds 速度 [-1, 1]，与组内电机一一对应
+ */
+void TB6612_Group_SetSpeed(const TB6612_Group_t* group, const float speeds[])
+{
+    TB6612_Group_Begin(group);
+    for (size_t i = 0; i < group->count; i++)
+        TB6612_SetSpeed(group->motors[i], speeds[i]);
+    TB6612_Group_Commit(group);
+}
+
+/**
+ * 初始化编码器 DMA 采样器
+ * @param sampler 采样器
+ * @param config 配置
+ */
+void TB6612_EncoderSampler_Init(TB6612_EncoderSampler_t*             sampler,
+                                const TB6612_EncoderSamplerConfig_t* config)
+{
+    sampler->config  = *config;
+    sampler->running = false;
+}
+
+/**
+ * 启动编码器 DMA 采样
+ *
+ * 每个 DMA 流以循环模式将对应编码器定时器的 CNT 搬运到 snapshot 中，
+ * 之后开启触发定时器的 DMA 请求，所有编码器在同一触发事件被采样
+ * @note 需要在各电机 TB6612_Enable 之后调用
+ * @param sampler 采样器
+ */
+void TB6612_EncoderSampler_Start(TB6612_EncoderSampler_t* sampler)
+{
+    const TB6612_EncoderSamplerConfig_t* config = &sampler->config;
+    for (size_t i = 0; i < config->count; i++)
+    {
+        TB6612_t* hmotor    = config->items[i].motor;
+        config->snapshot[i] = __HAL_TIM_GET_COUNTER(hmotor->encoder);
+        HAL_DMA_Start(config->items[i].hdma,
+                      (uint32_t) &hmotor->encoder->Instance->CNT,
+                      (uint32_t) &config->snapshot[i],
+                      1);
+    }
+    __HAL_TIM_ENABLE_DMA(config->trigger, config->dma_requests);
+    sampler->running = true;
+}
+
+/**
+ * 停止编码器 DMA 采样
+ * @param sampler 采样器
+ */
+void TB6612_EncoderSampler_Stop(TB6612_EncoderSampler_t* sampler)
+{
+    const TB6612_EncoderSamplerConfig_t* config = &sampler->config;
+    sampler->running                            = false;
+    __HAL_TIM_DISABLE_DMA(config->trigger, config->dma_requests);
+    for (size_t i = 0; i < config->count; i++)
+        HAL_DMA_Abort(config->items[i].hdma);
+}
+
+/**
+ * 解算 DMA 采样得到的所有编码器数据
+ * @note 本函数应当放置在触发定时器的更新回调中调用，替代逐个调用 TB6612_Encoder_DataDecode
+ * @note 捕获值只能在此时读取，与快照不是同一时刻，配对后 M/T 法转速会有偏差，
+ *       因此这里不使用 M/T 法，转速均按计数差分计算；需要 M/T 法的电机请单独调用 TB6612_Encoder_DataDecode
+ * @param sampler 采样器
+ */
+void TB6612_EncoderSampler_Decode(const TB6612_EncoderSampler_t* sampler)
+{
+    if (!sampler->running)
+        return;
+
+    const TB6612_EncoderSamplerConfig_t* config = &sampler->config;
+    for (size_t i = 0; i < config->count; i++)
+        counter_decode(config->items[i].motor, config->snapshot[i], false, false, 0);
 }
 
 #ifdef __cplusplus
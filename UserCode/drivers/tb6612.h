@@ -33,9 +33,71 @@ extern "C"
 
 #define __TB6612_VERSION__ "0.2.0"
 
+#include "bsp/cycle_profiler.h"
+#include "bsp/motor_pos.h"
 #include "bsp/gpio_driver.h"
 #include "bsp/pwm.h"
 
+/**
+ * 停止方式
+ */
+typedef enum
+{
+    TB6612_STOP_BRAKE = 0U, //< 短路制动 (IN1 = IN2 = H)
+    TB6612_STOP_COAST,      //< 滑行 (IN1 = IN2 = L，输出高阻)
+} TB6612_StopMode_t;
+
+/**
+ * IN1/IN2 状态
+ */
+typedef enum
+{
+    TB6612_PIN_STATE_NONE = 0U, //< 未设置
+    TB6612_PIN_STATE_FORWARD,   //< 正转 (IN1 = L, IN2 = H)
+    TB6612_PIN_STATE_REVERSE,   //< 反转 (IN1 = H, IN2 = L)
+    TB6612_PIN_STATE_BRAKE,     //< 短路制动 (IN1 = H, IN2 = H)
+    TB6612_PIN_STATE_COAST,     //< 滑行 (IN1 = L, IN2 = L)
+} TB6612_PinState_t;
+
+/**
+ * 定义 TB6612_VEL_FILTER_DISABLE 时不编译转速滤波 / 观测器，
+ * TB6612_t 中不再包含滤波状态，配置的估计方式均按 TB6612_VEL_FILTER_NONE 处理
+ */
+
+#ifndef TB6612_VEL_MA_SIZE_MAX
+/**
+ * 滑动平均滤波的最大窗口长度，决定 TB6612_t 中滤波状态的大小
+ */
+#    define TB6612_VEL_MA_SIZE_MAX (16)
+#endif
+
+/**
+ * 转速估计方式
+ */
+typedef enum
+{
+    TB6612_VEL_FILTER_NONE = 0U, //< 不滤波，直接使用差分 (或 M/T 法) 结果
+    TB6612_VEL_FILTER_IIR,       //< 一阶 IIR 低通
+    TB6612_VEL_FILTER_MA,        //< 滑动平均
+    TB6612_VEL_FILTER_OBSERVER,  //< 以占空比指令为输入的 Luenberger 观测器
+} TB6612_VelFilter_t;
+
+/**
+ * 转速估计配置
+ */
+typedef struct
+{
+    TB6612_VelFilter_t type; //< 估计方式，默认不滤波
+
+    float   alpha;   //< IIR: 滤波系数 (0, 1]，越小越平滑
+    uint8_t ma_size; //< MA: 窗口长度 [1, TB6612_VEL_MA_SIZE_MAX]
+
+    float tau;  //< 观测器: 电机机械时间常数 (unit: s)
+    float gain; //< 观测器: 满占空比下的稳态转速 (unit: rpm)
+    float l1;   //< 观测器: 角度修正增益
+    float l2;   //< 观测器: 转速修正增益 (unit: rpm/deg)
+} TB6612_VelFilterConfig_t;
+
 typedef struct
 {
     bool               enable;           //< 是否启用
@@ -48,10 +110,83 @@ typedef struct
     uint32_t           roto_radio;       //< 倍频器 * 线数
     float              reduction_radio;  //< 减速比
 
-    float angle;    //< 输出轴角度 (unit: deg)
-    float velocity; //< 输出轴转速 (unit: rpm)
+    TB6612_PinState_t pin_state;     //< 当前 IN1/IN2 状态
+    TB6612_StopMode_t stop_mode;     //< 停止方式
+    float             deadband;      //< 占空比绝对值不大于该值时停止
+    float             friction_duty; //< 静摩擦补偿占空比
+
+    bool             counter_32bit; //< 编码器定时器是否为 32 位计数器
+    uint32_t         last_counter;  //< 上一次采样的计数值
+    int64_t          ticks;         //< 累计计数值 (输出轴位置的整数表示)，64 位避免连续旋转时溢出
+    float            deg_per_tick;  //< 每个计数对应的输出轴角度 (unit: deg)
+    MotorPos_Ratio_t pos_ratio;     //< 每个输出圈对应的计数 (整数分子分母)，用于定点位置
+    float            rpm_per_tick;  //< 每个采样周期内一个计数对应的转速 (unit: rpm)
+
+    /**
+     * M/T 法测速，capture 为 NULL 时不启用
+     *
+     * 捕获定时器自由运行，其捕获通道需要在编码器每一次计数时都产生捕获，
+     * 一般将 A、B 相同时接入 CH1、CH2 并开启 TI1 异或输入 (TI1S)，CH1 配置为双边沿捕获
+     */
+    struct
+    {
+        TIM_HandleTypeDef* capture;         //< 捕获定时器
+        uint32_t           channel;         //< 捕获通道
+        uint32_t           flag;            //< 捕获通道对应的标志位
+        bool               counter_32bit;   //< 捕获定时器是否为 32 位计数器
+        float              rpm_factor;      //< 计数 / 捕获定时器计数 -> rpm 的系数
+        uint32_t           idle_max;        //< 无边沿时最多允许经过的采样周期数
+        bool               valid;           //< 是否已记录上一次边沿
+        uint32_t           last_edge_time;  //< 上一次边沿的捕获值
+        int64_t            last_edge_ticks; //< 上一次边沿时的累计计数值
+        uint32_t           idle_samples;    //< 自上一次边沿起经过的采样周期数
+    } mt;
+
+    /**
+     * 转速滤波 / 观测器状态，各估计方式的状态共用存储，
+     * 定义 TB6612_VEL_FILTER_DISABLE 时只保留 type
+     */
+    struct
+    {
+        TB6612_VelFilter_t type; //< 估计方式
+#ifndef TB6612_VEL_FILTER_DISABLE
+        union
+        {
+            struct
+            {
+                float alpha; //< 滤波系数
+            } iir;
+
+            struct
+            {
+                float   buffer[TB6612_VEL_MA_SIZE_MAX]; //< 环形缓冲区
+                float   sum;                            //< 窗口内求和
+                float   inv_size;                       //< 窗口长度的倒数
+                uint8_t size;                           //< 窗口长度
+                uint8_t index;                          //< 写入位置
+            } ma;
 
-    float duty_cmd; //< -1 ~ 1 占空比
+            struct
+            {
+                float k_model;    //< 采样周期 / 时间常数
+                float gain;       //< 满占空比稳态转速
+                float l1, l2;     //< 修正增益
+                float rpm_to_deg; //< 一个采样周期内 rpm -> deg 的系数
+                float angle;      //< 角度估计 (unit: deg)
+                float velocity;   //< 转速估计 (unit: rpm)
+            } obs;
+        };
+#endif
+    } vf;
+
+    float      angle;        //< 输出轴角度 (unit: deg)
+    MotorPos_t pos;          //< 输出轴位置 (定点)
+    float      velocity;     //< 输出轴转速 (unit: rpm)，经过滤波 / 观测
+    float      velocity_raw; //< 未经滤波的输出轴转速 (unit: rpm)
+
+    float duty_cmd; //< -1 ~ 1 占空比 (控制方向，未经 output_reverse 取反)
+
+    PROFILE_FIELD(decode_profile) //< 编码器解码耗时
 } TB6612_t;
 
 typedef struct
@@ -64,17 +199,89 @@ typedef struct
     float              sampling_period; //< 编码器采样间隔 (unit: s)
     uint32_t           roto_radio;      //< 倍频器 * 线数
     float              reduction_radio; //< 减速比
+
+    TB6612_StopMode_t stop_mode;     //< 停止方式，默认短路制动
+    float             deadband;      //< 占空比绝对值不大于该值时按 stop_mode 停止 (unit: 占空比)
+    float             friction_duty; //< 静摩擦补偿，非零输出映射到 [friction_duty, 1] (unit: 占空比)
+
+    TB6612_VelFilterConfig_t velocity_filter; //< 转速估计配置
+
+    TIM_HandleTypeDef* capture;         //< (可选) M/T 法测速使用的捕获定时器，NULL 表示不启用
+    uint32_t           capture_channel; //< 捕获通道
+    float              capture_freq;    //< 捕获定时器的计数频率 (unit: Hz)
 } TB6612_Config_t;
 
+/**
+ * 同步更新组
+ *
+ * 组内电机使用 CCR 预装载，TB6612_Group_Begin 暂停定时器的更新事件 (UDIS)，
+ * 在 TB6612_Group_Begin 和 TB6612_Group_Commit 之间写入的占空比会在同一个更新事件中同时生效
+ * @note 开启了更新中断 / 更新 DMA 或以更新事件作为 TRGO 的定时器不会被暂停，以免丢失共用的更新事件；
+ *       这类定时器上的通道仅依靠预装载同步，更新事件落在两次写入之间时会有一个 PWM 周期的错位，
+ *       需要严格同步的通道应放在不共用更新事件的 PWM 定时器上
+ */
+typedef struct
+{
+    TB6612_t** motors;       //< 组内电机
+    size_t     count;        //< 电机数量
+    bool       force_update; //< 提交时是否立即产生更新事件 (会重置计数器并触发更新中断 / DMA)
+} TB6612_Group_t;
+
+/**
+ * 编码器 DMA 采样项
+ */
+typedef struct
+{
+    TB6612_t*          motor; //< 电机
+    DMA_HandleTypeDef* hdma;  //< 外设 -> 内存、循环模式、32 位宽、地址不自增的 DMA 流
+} TB6612_EncoderSamplerItem_t;
+
+typedef struct
+{
+    TIM_HandleTypeDef*           trigger;      //< 触发采样的定时器
+    uint32_t                     dma_requests; //< 触发定时器需要开启的 DMA 请求 (TIM_DMA_*)
+    TB6612_EncoderSamplerItem_t* items;        //< 采样项
+    size_t                       count;        //< 采样项数量
+    volatile uint32_t*           snapshot;     //< 计数值快照，长度为 count
+} TB6612_EncoderSamplerConfig_t;
+
+/**
+ * 编码器 DMA 采样器
+ *
+ * 由同一个触发定时器的 DMA 请求 (如 TIMx_UP、TIMx_CHy) 驱动各 DMA 流，
+ * 在同一时刻把所有编码器的 CNT 快照到 snapshot 数组中，解算时只访问内存
+ * @note 快照中只有计数值，没有同一时刻的捕获值，采样器解算时不使用 M/T 法，
+ *       配置了捕获定时器的电机转速也按计数差分计算
+ */
+typedef struct
+{
+    TB6612_EncoderSamplerConfig_t config;  //< 配置
+    bool                          running; //< 是否已启动
+} TB6612_EncoderSampler_t;
+
 #define __TB6612_GET_ANGLE(__TB6612_HANDLE__)    (((TB6612_t*) (__TB6612_HANDLE__))->angle)
 #define __TB6612_GET_VELOCITY(__TB6612_HANDLE__) (((TB6612_t*) (__TB6612_HANDLE__))->velocity)
-#define __TB6612_RESET_ANGLE(__TB6612_HANDLE__)  (((TB6612_t*) (__TB6612_HANDLE__))->angle = 0.0f)
+#define __TB6612_GET_POS(__TB6612_HANDLE__)                                                        \
+    MotorPos_Load(&((TB6612_t*) (__TB6612_HANDLE__))->pos)
+#define __TB6612_RESET_ANGLE(__TB6612_HANDLE__)  TB6612_ResetAngle((TB6612_t*) (__TB6612_HANDLE__))
 
 void TB6612_SetSpeed(TB6612_t* hmotor, float speed);
 void TB6612_Enable(TB6612_t* hmotor);
 void TB6612_Disable(TB6612_t* hmotor);
 void TB6612_Init(TB6612_t* hmotor, const TB6612_Config_t* config);
 void TB6612_Encoder_DataDecode(TB6612_t* hmotor);
+void TB6612_ResetAngle(TB6612_t* hmotor);
+
+void TB6612_Group_Init(TB6612_Group_t* group, TB6612_t* motors[], size_t count, bool force_update);
+void TB6612_Group_Begin(const TB6612_Group_t* group);
+void TB6612_Group_Commit(const TB6612_Group_t* group);
+void TB6612_Group_SetSpeed(const TB6612_Group_t* group, const float speeds[]);
+
+void TB6612_EncoderSampler_Init(TB6612_EncoderSampler_t*             sampler,
+                                const TB6612_EncoderSamplerConfig_t* config);
+void TB6612_EncoderSampler_Start(TB6612_EncoderSampler_t* sampler);
+void TB6612_EncoderSampler_Stop(TB6612_EncoderSampler_t* sampler);
+void TB6612_EncoderSampler_Decode(const TB6612_EncoderSampler_t* sampler);
 
 #ifdef __cplusplus
 }
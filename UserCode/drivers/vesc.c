@@ -70,60 +70,66 @@ static VESC_t* get_vesc_handle(VESC_FeedbackMap* map, const CAN_RxHeaderTypeDef*
     return NULL;
 }
 
-static float clamp_value(const float value, const float max)
+/**
+ * set 类指令的编码参数
+ */
+typedef struct
 {
-    if (value > max)
-        return max;
-    if (value < -max)
-        return -max;
-    return value;
-}
+    float limit;      ///< 指令值限幅 (绝对值)
+    float scale;      ///< 编码倍率
+    bool  electrical; ///< 是否需要额外乘以电极数 (rpm -> erpm)
+} VESC_SetCmdScale_t;
+
+/**
+ * 各 set 类指令的编码参数表，scale 为 0 表示不支持的数据包
+ */
+static const VESC_SetCmdScale_t set_cmd_scale_map[] = {
+    // 设置占空比, Data: Duty Circle * 100,000 (int32)
+    [VESC_CAN_SET_DUTY] = { VESC_SET_DUTY_MAX, 1e5f, false },
+    // 设置电流, Data: current * 1000 (int32)
+    [VESC_CAN_SET_CURRENT] = { VESC_SET_CURRENT_MAX, 1e3f, false },
+    // 设置刹车电流, Data: current * 1000 (int32)
+    [VESC_CAN_SET_CURRENT_BRAKE] = { VESC_SET_CURRENT_BRAKE_MAX, 1e3f, false },
+    // 设置转速, Data: ERPM (int32)
+    [VESC_CAN_SET_RPM] = { VESC_SET_RPM_MAX, 1.0f, true },
+    // 设置位置, Data: pos * 1,000,000 (int32) unit: ?
+    [VESC_CAN_SET_POS] = { VESC_SET_POS_MAX, 1e6f, false },
+    // 设置相对电流，Data: ratio (-1 to 1) * 100,000 (int32). 相对于最大值和最小值
+    [VESC_CAN_SET_CURRENT_REL] = { VESC_SET_CURRENT_REL_MAX, 1e5f, false },
+    // 设置相对刹车电流，Data: ratio (-1 to 1) * 100,000 (int32). 相对于最大值和最小值
+    [VESC_CAN_SET_CURRENT_BRAKE_REL] = { VESC_SET_CURRENT_BRAKE_REL_MAX, 1e5f, false },
+};
+
+#define SET_CMD_SCALE_MAP_SIZE (sizeof(set_cmd_scale_map) / sizeof(set_cmd_scale_map[0]))
 
 /**
  * 获取 CAN 指令数据 ( - | int32 ) 类
+ *
+ * 限幅、缩放、打包一次完成：限幅使用条件选择而非分支，缩放在截断之前完成以保留精度，
+ * float -> int32 的转换由 FPU 的 VCVT 完成（硬件饱和）
  * @param pocket_id vesc can pocket id (set)
  * @param value 参数值
  * @param data 数据缓冲区
+ * @return 是否为支持的指令，不支持时 data 不会被写入
  */
-static void get_set_command_data(VESC_t*                    hvesc,
+static bool get_set_command_data(VESC_t*                    hvesc,
                                  const VESC_CAN_PocketSet_t pocket_id,
                                  const float                value,
                                  uint8_t                    data[])
 {
-    int32_t data_value;
-    switch (pocket_id)
-    {
-    case VESC_CAN_SET_DUTY:
-        // 设置占空比, Data: Duty Circle * 100,000 (int32)
-        data_value = (int32_t) (clamp_value(value, VESC_SET_DUTY_MAX) * 1e5f);
-        break;
-    case VESC_CAN_SET_CURRENT:
-        // 设置电流, Data: current * 1000 (int32)
-        data_value = (int32_t) (clamp_value(value, VESC_SET_CURRENT_MAX) * 1e3f);
-        break;
-    case VESC_CAN_SET_CURRENT_BRAKE:
-        // 设置刹车电流, Data: current * 1000 (int32)
-        data_value = (int32_t) (clamp_value(value, VESC_SET_CURRENT_BRAKE_MAX) * 1e3f);
-        break;
-    case VESC_CAN_SET_RPM:
-        // 设置转速, Data: ERPM (int32)
-        data_value = (int32_t) (clamp_value(value, VESC_SET_RPM_MAX)) * hvesc->electrodes;
-        break;
-    case VESC_CAN_SET_POS:
-        // 设置位置, Data: pos * 1,000,000 (int32) unit: ?
-        data_value = (int32_t) (clamp_value(value, VESC_SET_POS_MAX) * 1e6f);
-        break;
-    case VESC_CAN_SET_CURRENT_REL:
-        // 设置相对电流，Data: ratio (-1 to 1) * 100,000 (int32). 相对于最大值和最小值
-        data_value = (int32_t) (clamp_value(value, VESC_SET_CURRENT_REL_MAX) * 1e5);
-        break;
-    case VESC_CAN_SET_CURRENT_BRAKE_REL:
-        // 设置相对电流，Data: ratio (-1 to 1) * 100,000 (int32). 相对于最大值和最小值
-        data_value = (int32_t) (clamp_value(value, VESC_SET_CURRENT_BRAKE_REL_MAX) * 1e5);
-        break;
-    default:
-        return;
-    }
+    if ((size_t) pocket_id >= SET_CMD_SCALE_MAP_SIZE)
+        return false;
+    const VESC_SetCmdScale_t* cmd = &set_cmd_scale_map[pocket_id];
+    if (cmd->scale == 0.0f)
+        return false;
+
+    float v = value > cmd->limit ? cmd->limit : value;
+    v       = v < -cmd->limit ? -cmd->limit : v;
+
+    const float scale = cmd->electrical ? cmd->scale * (float) hvesc->electrodes //
+                                        : cmd->scale;
+    const int32_t data_value = (int32_t) (v * scale);
+
     data[0] = data_value >> 24;
     data[1] = data_value >> 16;
     data[2] = data_value >> 8;
@@ -132,6 +138,29 @@ static void get_set_command_data(VESC_t*                    hvesc,
     data[5] = 0x00;
     data[6] = 0x00;
     data[7] = 0x00;
+    return true;
+}
+
+/**
+ * 发送一帧 set 类指令
+ * @param hcan can handle
+ * @param pocket_id 数据包类型
+ * @param id 控制器 id
+ * @param data 已编码的数据
+ */
+static void send_set_frame(CAN_HandleTypeDef*         hcan,
+                           const VESC_CAN_PocketSet_t pocket_id,
+                           const uint8_t              id,
+                           const uint8_t              data[])
+{
+    CAN_SendMessage(hcan,
+                    &(CAN_TxHeaderTypeDef) {
+                            .ExtId = pocket_id << 8 | id,
+                            .IDE   = CAN_ID_EXT,
+                            .RTR   = CAN_RTR_DATA,
+                            .DLC   = 4,
+                    },
+                    data);
 }
 
 static void get_conf_command_data(const VESC_CAN_PocketConf_t pocket_id,
@@ -227,6 +256,9 @@ void VESC_CAN_DataDecode(VESC_t*                       hvesc,
         hvesc->feedback.pos = new_pos;
         hvesc->abs_angle    = (float) hvesc->feedback.round_cnt * 360.0f + hvesc->feedback.pos -
                            hvesc->angle_zero;
+        MotorPos_Store(&hvesc->abs_pos,
+                       (MotorPos_t) hvesc->feedback.round_cnt * MOTOR_POS_ONE_TURN +
+                               MotorPos_FromDeg(hvesc->feedback.pos - hvesc->angle_zero));
         break;
     case VESC_CAN_STATUS_5:
         hvesc->feedback.tachometer_value = (float) be_to_i32(data + 0);
@@ -248,6 +280,7 @@ void VESC_ResetAngle(VESC_t* hvesc)
     hvesc->feedback.round_cnt = 0;
     hvesc->angle_zero         = hvesc->feedback.pos;
     hvesc->abs_angle          = 0;
+    MotorPos_Store(&hvesc->abs_pos, 0);
 }
 
 /**
@@ -306,17 +339,72 @@ void VESC_Init(VESC_t* hvesc, const VESC_Config_t* config)
  */
 void VESC_SendSetCmd(VESC_t* hvesc, const VESC_CAN_PocketSet_t pocket_id, const float value)
 {
-    VESC_Eat(hvesc);
     static uint8_t data[8] = { 0 };
-    get_set_command_data(hvesc, pocket_id, value, data);
-    CAN_SendMessage(hvesc->hcan,
-                    &(CAN_TxHeaderTypeDef) {
-                            .ExtId = pocket_id << 8 | hvesc->id,
-                            .IDE   = CAN_ID_EXT,
-                            .RTR   = CAN_RTR_DATA,
-                            .DLC   = 4,
-                    },
-                    data);
+    if (!get_set_command_data(hvesc, pocket_id, value, data))
+        return;
+    VESC_Eat(hvesc);
+    send_set_frame(hvesc->hcan, pocket_id, hvesc->id, data);
+}
+
+/**
+ * 判断电机组是否恰好是某条 CAN 线上注册的全部 VESC
+ * @note 假定组内没有重复的电机
+ */
+static bool group_covers_bus(VESC_t* const hvescs[], const size_t count)
+{
+    const CAN_HandleTypeDef* hcan = hvescs[0]->hcan;
+    for (size_t i = 1; i < count; i++)
+        if (hvescs[i]->hcan != hcan)
+            return false;
+    for (size_t i = 0; i < map_size; i++)
+        if (map[i].hcan == hcan)
+            return map[i].size == count;
+    return false;
+}
+
+/**
+ * 向一组 VESC 发送指令
+ *
+ * 先完成所有数据的编码，再集中发送，尽量缩小各电机收到指令的时间差：
+ *  - 组内所有电机编码后的指令相同，且恰好覆盖该 CAN 线上的全部 VESC 时，只发送一帧广播
+ *  - 否则逐个电机背靠背连续发送，发送之间不再穿插任何计算
+ *
+ * @note VESC 协议不支持“在指定时刻生效”的指令，因此无法做到完全同步
+ * @param hvescs vesc handle 数组
+ * @param count 电机数量
+ * @param pocket_id 数据包类型
+ * @param values 每个电机的指令值，与 hvescs 一一对应
+ */
+void VESC_SendGroupSetCmd(VESC_t* const              hvescs[],
+                          const size_t               count,
+                          const VESC_CAN_PocketSet_t pocket_id,
+                          const float                values[])
+{
+    uint8_t data[VESC_CAN_NUM * VESC_NUM][8];
+
+    if (count == 0 || count > VESC_CAN_NUM * VESC_NUM)
+        return;
+
+    bool shared = true;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!get_set_command_data(hvescs[i], pocket_id, values[i], data[i]))
+            return; // 不支持的指令，不发送任何数据
+        if (memcmp(data[i], data[0], 4) != 0)
+            shared = false;
+    }
+
+    for (size_t i = 0; i < count; i++)
+        VESC_Eat(hvescs[i]);
+
+    if (shared && group_covers_bus(hvescs, count))
+    {
+        send_set_frame(hvescs[0]->hcan, pocket_id, VESC_BROADCAST_ID, data[0]);
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++)
+        send_set_frame(hvescs[i]->hcan, pocket_id, hvescs[i]->id, data[i]);
 }
 
 /**
@@ -354,7 +442,11 @@ void VESC_CAN_BaseReceiveCallback(const CAN_HandleTypeDef*   hcan,
         {
             VESC_t* hvesc = get_vesc_handle(&map[i], header);
             if (hvesc != NULL)
+            {
+                PROFILE_BEGIN();
                 VESC_CAN_DataDecode(hvesc, header->ExtId >> 8, data);
+                PROFILE_END(&hvesc->decode_profile);
+            }
             return;
         }
     }
@@ -30,6 +30,8 @@
 #include <stdbool.h>
 
 #include "main.h"
+#include "bsp/cycle_profiler.h"
+#include "bsp/motor_pos.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -47,6 +49,11 @@ extern "C"
 #    define VESC_NUM (16)
 #endif
 
+/**
+ * 广播 ID，同一 CAN 线上的所有 VESC 都会响应
+ */
+#define VESC_BROADCAST_ID (0xFFU)
+
 /* 参数范围限制 */
 #define VESC_SET_DUTY_MAX              (1.0f)
 #define VESC_SET_CURRENT_MAX           (2e6f)
@@ -193,8 +200,11 @@ typedef struct
         int32_t round_cnt; ///< 圈数统计
     } feedback;
 
-    float velocity;
-    float abs_angle;
+    float      velocity;
+    float      abs_angle;
+    MotorPos_t abs_pos; ///< 输出位置 (定点)
+
+    PROFILE_FIELD(decode_profile) ///< 反馈解码耗时
 } VESC_t;
 
 typedef struct
@@ -207,11 +217,16 @@ typedef struct
 
 #define __VESC_GET_ANGLE(__VESC_HANDLE__)    (((VESC_t*) (__VESC_HANDLE__))->abs_angle)
 #define __VESC_GET_VELOCITY(__VESC_HANDLE__) (((VESC_t*) (__VESC_HANDLE__))->velocity)
+#define __VESC_GET_POS(__VESC_HANDLE__)      MotorPos_Load(&((VESC_t*) (__VESC_HANDLE__))->abs_pos)
 
 void              VESC_Init(VESC_t* hvesc, const VESC_Config_t* config);
 HAL_StatusTypeDef VESC_CAN_FilterInit(CAN_HandleTypeDef* hcan, uint32_t filter_bank);
 void              VESC_ResetAngle(VESC_t* hvesc);
 void              VESC_SendSetCmd(VESC_t* hvesc, VESC_CAN_PocketSet_t pocket_id, float value);
+void              VESC_SendGroupSetCmd(VESC_t* const        hvescs[],
+                                       size_t               count,
+                                       VESC_CAN_PocketSet_t pocket_id,
+                                       const float          values[]);
 void              VESC_CAN_Fifo0ReceiveCallback(CAN_HandleTypeDef* hcan);
 void              VESC_CAN_BaseReceiveCallback(const CAN_HandleTypeDef*   hcan,
                                                const CAN_RxHeaderTypeDef* header,
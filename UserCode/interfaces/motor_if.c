@@ -23,6 +23,7 @@
  * Project repository: https://github.com/HITSZ-WTR2026/motor_drivers
  */
 #include "motor_if.h"
+#include "main.h"
 #include <math.h>
 #include <string.h>
 
@@ -32,125 +33,596 @@ extern "C"
 #endif
 
 /******** 🛠️⚠️ 电机扩展提醒块 ⚠️🛠️ ********
- * 新增电机时需要在 motor_if.c 中实现：
- * 1. motor_apply_output, 对于无电流控制的电机可忽略
- * 2. motor_send_internal_velocity, 对于无内部速度控制的电机可忽略
- * 3. motor_send_internal_position, 对于无内部位置控制的电机可忽略
- * 4. get_default_ctrl_mode: 最好和当前一样通过 宏 定义默认值
+ * 新增电机时需要在 motor_if.c 中：
+ * 1. 实现该电机的 Motor_Ops_t，不支持的操作使用 motor_nop_* 填充
+ *    - apply_output, 对于无电流控制的电机为空操作
+ *    - send_velocity, 对于无内部速度控制的电机为空操作
+ *    - send_position, 对于无内部位置控制的电机为空操作
+ *    - apply_current, 以电机的原生电流单位下发电流 (力矩) 指令
+ *    - default_ctrl_mode: 最好和当前一样通过 宏 定义默认值
+ * 2. 将操作表加入 motor_ops_map
  ****************************************/
 
+static void motor_nop_output(void* hmotor, const float value)
+{
+    (void) hmotor;
+    (void) value;
+}
+
+static void motor_nop_reset(void* hmotor)
+{
+    (void) hmotor;
+}
+
+static float motor_nop_get(void* hmotor)
+{
+    (void) hmotor;
+    return 0.0f;
+}
+
+static MotorPos_t motor_nop_get_pos(void* hmotor)
+{
+    (void) hmotor;
+    return 0;
+}
+
+static Motor_State_t motor_nop_get_state(void* hmotor)
+{
+    (void) hmotor;
+    return (Motor_State_t) { 0.0f, 0.0f, 0 };
+}
+
 /**
- * 应用电流控制
- * @param motor_type 电机类型
- * @param hmotor 电机数据
- * @param output 电流 （或占空比）
+ * 空操作表，用于未知的电机类型
  */
-static inline void motor_apply_output(const MotorType_t motor_type,
-                                      void*             hmotor,
-                                      const float       output)
+static const Motor_Ops_t motor_nop_ops = {
+    .get_state         = motor_nop_get_state,
+    .get_angle         = motor_nop_get,
+    .get_velocity      = motor_nop_get,
+    .get_pos           = motor_nop_get_pos,
+    .apply_output      = motor_nop_output,
+    .send_velocity     = motor_nop_output,
+    .send_position     = motor_nop_output,
+    .apply_current     = motor_nop_output,
+    .reset_angle       = motor_nop_reset,
+    .default_ctrl_mode = MOTOR_CTRL_EXTERNAL_PID,
+};
+
+#ifdef USE_DJI
+static Motor_State_t dji_get_state(void* hmotor)
+{
+    return (Motor_State_t) {
+        __DJI_GET_ANGLE(hmotor),
+        __DJI_GET_VELOCITY(hmotor),
+        __DJI_GET_POS(hmotor),
+    };
+}
+
+static float dji_get_angle(void* hmotor)
+{
+    return __DJI_GET_ANGLE(hmotor);
+}
+
+static float dji_get_velocity(void* hmotor)
+{
+    return __DJI_GET_VELOCITY(hmotor);
+}
+
+static MotorPos_t dji_get_pos(void* hmotor)
+{
+    return __DJI_GET_POS(hmotor);
+}
+
+static void dji_apply_output(void* hmotor, const float output)
 {
     // ATTENTION: 此处不做输出限幅校验，输出限幅应当放在 PID 参数中
-    switch (motor_type)
-    {
-#ifdef USE_DJI
-    case MOTOR_TYPE_DJI:
-        __DJI_SET_IQ_CMD(hmotor, output);
-        break;
+    __DJI_SET_IQ_CMD(hmotor, output);
+}
+
+static void dji_apply_current(void* hmotor, const float current)
+{
+    DJI_SetCurrent(hmotor, current);
+}
+
+static void dji_reset_angle(void* hmotor)
+{
+    DJI_ResetAngle(hmotor);
+}
+
+static const Motor_Ops_t dji_ops = {
+    .get_state         = dji_get_state,
+    .get_angle         = dji_get_angle,
+    .get_velocity      = dji_get_velocity,
+    .get_pos           = dji_get_pos,
+    .apply_output      = dji_apply_output,
+    .send_velocity     = motor_nop_output,
+    .send_position     = motor_nop_output,
+    .apply_current     = dji_apply_current,
+    .reset_angle       = dji_reset_angle,
+    .default_ctrl_mode = MOTOR_DEFAULT_MODE_DJI,
+};
 #endif
+
 #ifdef USE_TB6612
-    case MOTOR_TYPE_TB6612:
-        return TB6612_SetSpeed(hmotor, output);
+static Motor_State_t tb6612_get_state(void* hmotor)
+{
+    return (Motor_State_t) {
+        __TB6612_GET_ANGLE(hmotor),
+        __TB6612_GET_VELOCITY(hmotor),
+        __TB6612_GET_POS(hmotor),
+    };
+}
+
+static float tb6612_get_angle(void* hmotor)
+{
+    return __TB6612_GET_ANGLE(hmotor);
+}
+
+static float tb6612_get_velocity(void* hmotor)
+{
+    return __TB6612_GET_VELOCITY(hmotor);
+}
+
+static MotorPos_t tb6612_get_pos(void* hmotor)
+{
+    return __TB6612_GET_POS(hmotor);
+}
+
+static void tb6612_apply_output(void* hmotor, const float output)
+{
+    TB6612_SetSpeed(hmotor, output);
+}
+
+static void tb6612_reset_angle(void* hmotor)
+{
+    __TB6612_RESET_ANGLE(hmotor);
+}
+
+static const Motor_Ops_t tb6612_ops = {
+    .get_state         = tb6612_get_state,
+    .get_angle         = tb6612_get_angle,
+    .get_velocity      = tb6612_get_velocity,
+    .get_pos           = tb6612_get_pos,
+    .apply_output      = tb6612_apply_output,
+    .send_velocity     = motor_nop_output,
+    .send_position     = motor_nop_output,
+    .apply_current     = tb6612_apply_output, // 以占空比近似力矩
+    .reset_angle       = tb6612_reset_angle,
+    .default_ctrl_mode = MOTOR_DEFAULT_MODE_TB6612,
+};
 #endif
+
 #ifdef USE_VESC
-    case MOTOR_TYPE_VESC:
-        /* VESC 电调不应在控制时设置电流 */
-        return;
-#endif
-#ifdef USE_DM
-    case MOTOR_TYPE_DM:
-        /* DM 电调不应该在控制时设置电流*/
-        break;
-#endif
-    default:
-        break;
-    }
+static Motor_State_t vesc_get_state(void* hmotor)
+{
+    return (Motor_State_t) {
+        __VESC_GET_ANGLE(hmotor),
+        __VESC_GET_VELOCITY(hmotor),
+        __VESC_GET_POS(hmotor),
+    };
 }
 
-/**
- * 发送电机内部速度控制指令
- * @param motor_type 电机类型
- * @param hmotor 电机对象
- * @param speed 速度
- */
-static inline void motor_send_internal_velocity(const MotorType_t motor_type,
-                                                void*             hmotor,
-                                                const float       speed)
+static float vesc_get_angle(void* hmotor)
 {
-    switch (motor_type)
-    {
-#ifdef USE_VESC
-    case MOTOR_TYPE_VESC:
-        VESC_SendSetCmd(hmotor, VESC_CAN_SET_RPM, speed);
-        break;
+    return __VESC_GET_ANGLE(hmotor);
+}
+
+static float vesc_get_velocity(void* hmotor)
+{
+    return __VESC_GET_VELOCITY(hmotor);
+}
+
+static MotorPos_t vesc_get_pos(void* hmotor)
+{
+    return __VESC_GET_POS(hmotor);
+}
+
+static void vesc_send_velocity(void* hmotor, const float velocity)
+{
+    VESC_SendSetCmd(hmotor, VESC_CAN_SET_RPM, velocity);
+}
+
+static void vesc_apply_current(void* hmotor, const float current)
+{
+    VESC_SendSetCmd(hmotor, VESC_CAN_SET_CURRENT, current);
+}
+
+static void vesc_reset_angle(void* hmotor)
+{
+    VESC_ResetAngle(hmotor);
+}
+
+static const Motor_Ops_t vesc_ops = {
+    .get_state     = vesc_get_state,
+    .get_angle     = vesc_get_angle,
+    .get_velocity  = vesc_get_velocity,
+    .get_pos       = vesc_get_pos,
+    .apply_output  = motor_nop_output, // VESC 电调不应在控制时设置电流
+    .send_velocity = vesc_send_velocity,
+    // 这里并不是普遍意义下的多圈位置，VESC_CAN_SET_POS 仅是单圈位置
+    .send_position     = motor_nop_output,
+    .apply_current     = vesc_apply_current,
+    .reset_angle       = vesc_reset_angle,
+    .default_ctrl_mode = MOTOR_DEFAULT_MODE_VESC,
+};
 #endif
 
 #ifdef USE_DM
-    case MOTOR_TYPE_DM:
-        DM_Vel_SendSetCmd(hmotor, speed);
-        break;
-#endif
-    default:
-        break;
-    }
+static Motor_State_t dm_get_state(void* hmotor)
+{
+    return (Motor_State_t) {
+        __DM_GET_ANGLE(hmotor),
+        __DM_GET_VELOCITY(hmotor),
+        __DM_GET_POS(hmotor),
+    };
 }
 
-static inline void motor_send_internal_position(const MotorType_t motor_type,
-                                                void*             hmotor,
-                                                const float       position)
+static float dm_get_angle(void* hmotor)
 {
-    switch (motor_type)
-    {
+    return __DM_GET_ANGLE(hmotor);
+}
+
+static float dm_get_velocity(void* hmotor)
+{
+    return __DM_GET_VELOCITY(hmotor);
+}
+
+static MotorPos_t dm_get_pos(void* hmotor)
+{
+    return __DM_GET_POS(hmotor);
+}
+
+static void dm_send_velocity(void* hmotor, const float velocity)
+{
+    DM_Vel_SendSetCmd(hmotor, velocity);
+}
+
+static void dm_apply_current(void* hmotor, const float torque)
+{
+    DM_MIT_SendTorqueCmd(hmotor, torque);
+}
+
+static const Motor_Ops_t dm_ops = {
+    .get_state     = dm_get_state,
+    .get_angle     = dm_get_angle,
+    .get_velocity  = dm_get_velocity,
+    .get_pos       = dm_get_pos,
+    .apply_output  = motor_nop_output, // DM 电调不应该在控制时设置电流
+    .send_velocity = dm_send_velocity,
+    // DM_Pos_SendSetCmd 暂未接入
+    .send_position     = motor_nop_output,
+    .apply_current     = dm_apply_current,
+    .reset_angle       = motor_nop_reset,
+    .default_ctrl_mode = MOTOR_DEFAULT_MODE_DM,
+};
+#endif
+
+/**
+ * 电机类型 -> 操作表
+ */
+static const Motor_Ops_t* const motor_ops_map[MOTOR_TYPE_COUNT] = {
+#ifdef USE_DJI
+    [MOTOR_TYPE_DJI] = &dji_ops,
+#endif
+#ifdef USE_TB6612
+    [MOTOR_TYPE_TB6612] = &tb6612_ops,
+#endif
 #ifdef USE_VESC
-    case MOTOR_TYPE_VESC:
-        // 这里并不是普遍意义下的多圈位置，这里仅是单圈位置
-        // VESC_SendSetCmd(hmotor, VESC_CAN_SET_POS, position);
-        // break;
-        return;
+    [MOTOR_TYPE_VESC] = &vesc_ops,
 #endif
 #ifdef USE_DM
-    case MOTOR_TYPE_DM:
-        // DM_Pos_SendSetCmd(hmotor,position);
-        return;
+    [MOTOR_TYPE_DM] = &dm_ops,
 #endif
-    default:
-        break;
-    }
+};
+
+/**
+ * 获取电机操作表
+ * @param motor_type 电机类型
+ * @return 操作表，未知类型返回空操作表
+ */
+const Motor_Ops_t* Motor_GetOps(const MotorType_t motor_type)
+{
+    if ((unsigned) motor_type >= MOTOR_TYPE_COUNT || motor_ops_map[motor_type] == NULL)
+        return &motor_nop_ops;
+    return motor_ops_map[motor_type];
 }
 
-static inline MotorCtrlMode_t get_default_ctrl_mode(const MotorType_t motor_type)
+/**
+ * 电机注册表
+ *
+ * 电机指针与句柄分别连续存放，遍历全部电机时只需顺序访问两个数组
+ */
+static struct
 {
-    switch (motor_type)
+    void*          motors[MOTOR_REGISTRY_MAX];  ///< 电机
+    Motor_Handle_t handles[MOTOR_REGISTRY_MAX]; ///< 句柄
+    size_t         count;                       ///< 已注册的电机数
+
+    const void* buses[MOTOR_REGISTRY_BUS_MAX]; ///< 总线编号 -> 总线
+    size_t      bus_count;                     ///< 已分配的总线数
+} registry;
+
+/**
+ * 注册电机，只由各电机类型的注册函数调用，保证类型与指针匹配
+ * @param motor_type 电机类型
+ * @param motor 电机
+ * @param bus 所在总线的 CAN 实例 (CAN_TypeDef*)，NULL 表示无总线
+ * @return 句柄，已注册过的电机返回原句柄，注册表已满时返回 MOTOR_HANDLE_INVALID
+ */
+static Motor_Handle_t motor_register(const MotorType_t motor_type, void* motor, const void* bus)
+{
+    for (size_t i = 0; i < registry.count; i++)
+        if (registry.motors[i] == motor)
+            return registry.handles[i];
+
+    uint8_t bus_id = MOTOR_BUS_NONE;
+    if (bus != NULL)
     {
+        size_t i = 0;
+        while (i < registry.bus_count && registry.buses[i] != bus)
+            i++;
+        if (i == registry.bus_count)
+        {
+            if (registry.bus_count >= MOTOR_REGISTRY_BUS_MAX)
+                return MOTOR_HANDLE_INVALID;
+            registry.buses[registry.bus_count++] = bus;
+        }
+        bus_id = (uint8_t) i;
+    }
+
+    if (registry.count >= MOTOR_REGISTRY_MAX)
+        return MOTOR_HANDLE_INVALID;
+
+    const Motor_Handle_t handle = {
+        .bus   = bus_id,
+        .type  = (uint8_t) motor_type,
+        .index = (uint16_t) registry.count,
+    };
+    registry.motors[registry.count]  = motor;
+    registry.handles[registry.count] = handle;
+    registry.count++;
+    return handle;
+}
+
 #ifdef USE_DJI
-    case MOTOR_TYPE_DJI:
-        return MOTOR_DEFAULT_MODE_DJI;
+/**
+ * 注册大疆电机，需在 DJI_Init 之后调用
+ * @param hdji 电机
+ * @return 句柄
+ */
+Motor_Handle_t Motor_Register_DJI(DJI_t* hdji)
+{
+    return motor_register(MOTOR_TYPE_DJI, hdji, hdji->can);
+}
 #endif
+
 #ifdef USE_TB6612
-    case MOTOR_TYPE_TB6612:
-        return MOTOR_DEFAULT_MODE_TB6612;
+/**
+ * 注册 TB6612 驱动的电机
+ * @param htb6612 电机
+ * @return 句柄
+ */
+Motor_Handle_t Motor_Register_TB6612(TB6612_t* htb6612)
+{
+    return motor_register(MOTOR_TYPE_TB6612, htb6612, NULL);
+}
 #endif
+
 #ifdef USE_VESC
-    case MOTOR_TYPE_VESC:
-        return MOTOR_DEFAULT_MODE_VESC;
+/**
+ * 注册 VESC 电调驱动的电机，需在 VESC_Init 之后调用
+ * @param hvesc 电机
+ * @return 句柄
+ */
+Motor_Handle_t Motor_Register_VESC(VESC_t* hvesc)
+{
+    return motor_register(MOTOR_TYPE_VESC, hvesc, hvesc->hcan->Instance);
+}
 #endif
+
 #ifdef USE_DM
-    case MOTOR_TYPE_DM:
-        return MOTOR_DEFAULT_MODE_DM;
+/**
+ * 注册达妙电机，需在 DM_Init 之后调用
+ * @param hdm 电机
+ * @return 句柄
+ */
+Motor_Handle_t Motor_Register_DM(DM_t* hdm)
+{
+    return motor_register(MOTOR_TYPE_DM, hdm, hdm->hcan->Instance);
+}
 #endif
 
+/**
+ * 获取已注册的电机数
+ * @return 电机数
+ */
+size_t Motor_Registry_Count(void)
+{
+    return registry.count;
+}
+
+/**
+ * 按注册顺序获取句柄，用于遍历全部电机
+ * @param index 下标，小于 Motor_Registry_Count()
+ * @return 句柄，越界时返回 MOTOR_HANDLE_INVALID
+ */
+Motor_Handle_t Motor_Registry_Get(const size_t index)
+{
+    return index < registry.count ? registry.handles[index] : MOTOR_HANDLE_INVALID;
+}
+
+/**
+ * 判断句柄是否由注册表发放
+ *
+ * 句柄按值传递，调用方持有的是副本；总线、类型、下标必须与注册表中记录的句柄完全一致，
+ * 手工构造、过期或被破坏的句柄都不会通过
+ * @param handle 句柄
+ * @return 是否与注册表中的记录一致
+ */
+bool Motor_Registry_Contains(const Motor_Handle_t handle)
+{
+    if (handle.index >= registry.count)
+        return false;
+    const Motor_Handle_t stored = registry.handles[handle.index];
+    return stored.bus == handle.bus && stored.type == handle.type && stored.index == handle.index;
+}
+
+/**
+ * 获取句柄对应电机的类型
+ * @param handle 句柄
+ * @return 注册时记录的类型，无效句柄返回 MOTOR_TYPE_COUNT
+ */
+MotorType_t Motor_Registry_GetType(const Motor_Handle_t handle)
+{
+    return Motor_Registry_Contains(handle) ? (MotorType_t) registry.handles[handle.index].type
+                                           : MOTOR_TYPE_COUNT;
+}
+
+/**
+ * 获取句柄对应的电机
+ * @param handle 句柄
+ * @return 电机，无效句柄返回 NULL
+ */
+void* Motor_Registry_GetMotor(const Motor_Handle_t handle)
+{
+    return Motor_Registry_Contains(handle) ? registry.motors[handle.index] : NULL;
+}
+
+/**
+ * 以指定类型获取句柄对应的电机
+ * @param handle 句柄
+ * @param motor_type 期望的电机类型
+ * @return 电机，类型不符或句柄无效时返回 NULL
+ */
+void* Motor_Registry_GetMotorAs(const Motor_Handle_t handle, const MotorType_t motor_type)
+{
+    const MotorType_t type = Motor_Registry_GetType(handle);
+    return type != MOTOR_TYPE_COUNT && type == motor_type ? registry.motors[handle.index] : NULL;
+}
+
+/**
+ * 获取句柄对应电机所在的总线
+ * @param handle 句柄
+ * @return 总线的 CAN 实例 (CAN_TypeDef*)，无总线或句柄无效时返回 NULL
+ */
+const void* Motor_Registry_GetBus(const Motor_Handle_t handle)
+{
+    if (!Motor_Registry_Contains(handle) || handle.bus >= registry.bus_count)
+        return NULL;
+    return registry.buses[handle.bus];
+}
+
+/**
+ * 初始化发送策略
+ */
+static void tx_policy_init(Motor_TxPolicy_t* tx, const float deadband, const uint32_t keepalive_ms)
+{
+    tx->deadband     = deadband;
+    tx->keepalive_ms = keepalive_ms;
+    tx->last_value   = 0.0f;
+    tx->last_tick    = 0;
+    tx->sent         = false;
+}
+
+/**
+ * 判断本次是否需要发送，需要发送时记录发送值和时刻
+ * @param tx 发送策略
+ * @param value 本次指令
+ * @return 是否需要发送
+ */
+static bool tx_policy_check(Motor_TxPolicy_t* tx, const float value)
+{
+    if (tx->keepalive_ms == 0)
+        return true;
+
+    const uint32_t now = HAL_GetTick();
+    if (tx->sent && fabsf(value - tx->last_value) <= tx->deadband &&
+        now - tx->last_tick < tx->keepalive_ms)
+        return false;
+
+    tx->last_value = value;
+    tx->last_tick  = now;
+    tx->sent       = true;
+    return true;
+}
+
+/**
+ * 初始化增益调度表，断点表为空时不启用调度
+ */
+static void gain_sched_init(Motor_GainSched_t* sched, const Motor_GainSchedConfig_t* config)
+{
+    const bool valid = config->points != NULL && config->count > 0;
+
+    sched->key    = valid ? config->key : MOTOR_GAIN_SCHED_NONE;
+    sched->points = config->points;
+    sched->count  = valid ? config->count : 0;
+    sched->index  = 0;
+    sched->input  = 0.0f;
+}
+
+/**
+ * 按调度变量插值并写入 PID 参数
+ *
+ * 从上次所在区间开始向两侧查找，调度变量每周期只会小幅变化，一般不需要移动
+ * @param sched 增益调度表
+ * @param pid PID
+ * @param velocity 转速绝对值
+ * @param error 误差绝对值
+ */
+static void gain_sched_apply(Motor_GainSched_t* sched,
+                             MotorPID_t*        pid,
+                             const float        velocity,
+                             const float        error)
+{
+    float x;
+    switch (sched->key)
+    {
+    case MOTOR_GAIN_SCHED_VELOCITY:
+        x = velocity;
+        break;
+    case MOTOR_GAIN_SCHED_ERROR:
+        x = error;
+        break;
+    case MOTOR_GAIN_SCHED_USER:
+        x = sched->input;
+        break;
     default:
-        return MOTOR_CTRL_EXTERNAL_PID;
+        return;
     }
+
+    const Motor_GainPoint_t* points = sched->points;
+    const size_t             last   = sched->count - 1;
+
+    if (x <= points[0].x || last == 0)
+    {
+        pid->Kp = points[0].Kp;
+        pid->Ki = points[0].Ki;
+        pid->Kd = points[0].Kd;
+        return;
+    }
+    if (x >= points[last].x)
+    {
+        pid->Kp = points[last].Kp;
+        pid->Ki = points[last].Ki;
+        pid->Kd = points[last].Kd;
+        return;
+    }
+
+    // 保证 points[i].x <= x < points[i + 1].x
+    size_t i = sched->index < last ? sched->index : last - 1;
+    while (i > 0 && x < points[i].x)
+        i--;
+    while (i < last - 1 && x >= points[i + 1].x)
+        i++;
+    sched->index = i;
+
+    const Motor_GainPoint_t* lo = &points[i];
+    const Motor_GainPoint_t* hi = &points[i + 1];
+    const float              t  = (x - lo->x) / (hi->x - lo->x);
+
+    pid->Kp = lo->Kp + t * (hi->Kp - lo->Kp);
+    pid->Ki = lo->Ki + t * (hi->Ki - lo->Ki);
+    pid->Kd = lo->Kd + t * (hi->Kd - lo->Kd);
 }
 
 /**
@@ -197,18 +669,42 @@ static inline void motor_posctrl_mode_init(Motor_PosCtrl_t*             hctrl,
 void Motor_PosCtrl_Init(Motor_PosCtrl_t* hctrl, const Motor_PosCtrlConfig_t* config)
 {
     hctrl->motor_type = config->motor_type;
+    hctrl->ops        = Motor_GetOps(config->motor_type);
     hctrl->motor      = config->motor;
 #ifdef USE_CUSTOM_CTRL_MODE
-    hctrl->ctrl_mode = config.ctrl_mode;
+    hctrl->ctrl_mode = config->ctrl_mode;
 #else
-    hctrl->ctrl_mode = get_default_ctrl_mode(config->motor_type);
+    hctrl->ctrl_mode = hctrl->ops->default_ctrl_mode;
 #endif
 
     motor_posctrl_mode_init(hctrl, config);
 
-    hctrl->settle.count_max       = config->settle_count_max ? config->settle_count_max : 50;
-    hctrl->settle.error_threshold = config->error_threshold;
-    hctrl->settle.counter         = 0;
+    hctrl->settle.count_max          = config->settle_count_max ? config->settle_count_max : 50;
+    hctrl->settle.error_threshold    = config->error_threshold;
+    hctrl->settle.velocity_threshold = config->settle_velocity_threshold;
+    hctrl->settle.timeout            = config->settle_timeout;
+    hctrl->settle.counter            = 0;
+    hctrl->settle.elapsed            = 0;
+    hctrl->settle.done               = false;
+    hctrl->settle.callback           = NULL;
+#ifdef USE_RTOS
+    hctrl->settle.event_flags = NULL;
+#endif
+
+    tx_policy_init(&hctrl->tx, config->tx_deadband, config->tx_keepalive_ms);
+    PROFILE_RESET(&hctrl->profile);
+
+    hctrl->feedforward.velocity     = 0.0f;
+    hctrl->feedforward.acceleration = 0.0f;
+    hctrl->feedforward.torque       = 0.0f;
+    hctrl->feedforward.inertia      = config->ff_inertia;
+    hctrl->feedforward.friction     = config->ff_friction;
+
+    gain_sched_init(&hctrl->gain_sched.velocity, &config->velocity_gain_sched);
+    gain_sched_init(&hctrl->gain_sched.position, &config->position_gain_sched);
+
+    hctrl->tune.pending = NULL;
+    hctrl->tune.back    = 0;
 
     hctrl->enable = false;
 }
@@ -247,50 +743,288 @@ static inline void motor_velctrl_mode_init(Motor_VelCtrl_t*             hctrl,
 void Motor_VelCtrl_Init(Motor_VelCtrl_t* hctrl, const Motor_VelCtrlConfig_t* config)
 {
     hctrl->motor_type = config->motor_type;
+    hctrl->ops        = Motor_GetOps(config->motor_type);
     hctrl->motor      = config->motor;
 #ifdef USE_CUSTOM_CTRL_MODE
-    hctrl->ctrl_mode = config.ctrl_mode;
+    hctrl->ctrl_mode = config->ctrl_mode;
 #else
-    hctrl->ctrl_mode = get_default_ctrl_mode(config->motor_type);
+    hctrl->ctrl_mode = hctrl->ops->default_ctrl_mode;
 #endif
 
     motor_velctrl_mode_init(hctrl, config);
 
+    tx_policy_init(&hctrl->tx, config->tx_deadband, config->tx_keepalive_ms);
+    gain_sched_init(&hctrl->gain_sched, &config->gain_sched);
+    PROFILE_RESET(&hctrl->profile);
+
+    hctrl->tune.pending = NULL;
+    hctrl->tune.back    = 0;
+
     hctrl->enable = false;
 }
 
 /**
- * 位置环控制计算
+ * 初始化电流 (力矩) 控制对象
  * @param hctrl 受控对象
+ * @param config 配置
  */
-void Motor_PosCtrlUpdate(Motor_PosCtrl_t* hctrl)
+void Motor_CurCtrl_Init(Motor_CurCtrl_t* hctrl, const Motor_CurCtrlConfig_t* config)
 {
-    if (!hctrl->enable)
-        return;
+    hctrl->motor_type      = config->motor_type;
+    hctrl->ops             = Motor_GetOps(config->motor_type);
+    hctrl->motor           = config->motor;
+    hctrl->torque_constant = config->torque_constant > 0 ? config->torque_constant : 1.0f;
+    hctrl->abs_current_max = config->abs_current_max;
+    hctrl->rate_limit      = config->rate_limit;
+    hctrl->current         = 0.0f;
+    hctrl->output          = 0.0f;
+    PROFILE_RESET(&hctrl->profile);
 
-    ++hctrl->count;
+    hctrl->enable = false;
+}
 
-    const float angle = Motor_GetAngle(hctrl->motor_type, hctrl->motor);
-    // 检测电机是否就位
-    if (fabsf(angle - hctrl->position_pid.ref) < hctrl->settle.error_threshold)
+/**
+ * 触发就位事件
+ */
+static void motor_posctrl_settle_notify(Motor_PosCtrl_t* hctrl, const Motor_SettleEvent_t event)
+{
+    hctrl->settle.done = true;
+    if (hctrl->settle.callback != NULL)
+        hctrl->settle.callback(hctrl, event);
+#ifdef USE_RTOS
+    if (hctrl->settle.event_flags != NULL)
+        osEventFlagsSet(hctrl->settle.event_flags,
+                        event == MOTOR_SETTLE_EVENT_SETTLED ? hctrl->settle.settled_flag
+                                                            : hctrl->settle.timeout_flag);
+#endif
+}
+
+/**
+ * 就位判断
+ *
+ * 以控制目标 target 为准 (而不是只在外环周期刷新、内部环模式下无效的 position_pid.ref)，
+ * 误差和转速同时在范围内并保持 count_max 个周期认为就位
+ * @param hctrl 受控对象
+ * @param abs_error 位置误差绝对值 (unit: deg)
+ * @param abs_velocity 转速绝对值 (unit: rpm)
+ */
+static void motor_posctrl_settle_update(Motor_PosCtrl_t* hctrl,
+                                        const float      abs_error,
+                                        const float      abs_velocity)
+{
+    const bool in_position = abs_error < hctrl->settle.error_threshold;
+    const bool in_velocity = hctrl->settle.velocity_threshold <= 0 ||
+                             abs_velocity < hctrl->settle.velocity_threshold;
+
+    if (in_position && in_velocity)
         ++hctrl->settle.counter;
     else
         hctrl->settle.counter = 0;
 
+    if (hctrl->settle.done)
+        return;
+
+    ++hctrl->settle.elapsed;
+    if (hctrl->settle.counter >= hctrl->settle.count_max)
+        motor_posctrl_settle_notify(hctrl, MOTOR_SETTLE_EVENT_SETTLED);
+    else if (hctrl->settle.timeout != 0 && hctrl->settle.elapsed >= hctrl->settle.timeout)
+        motor_posctrl_settle_notify(hctrl, MOTOR_SETTLE_EVENT_TIMEOUT);
+}
+
+/**
+ * 重新开始就位判断，目标改变时会自动调用，目标不变时可用于重新触发就位事件
+ * @param hctrl 受控对象
+ */
+void Motor_PosCtrl_ResetSettle(Motor_PosCtrl_t* hctrl)
+{
+    hctrl->settle.done    = true; // 先屏蔽事件，避免在清零过程中被中断触发
+    hctrl->settle.counter = 0;
+    hctrl->settle.elapsed = 0;
+#ifdef USE_RTOS
+    if (hctrl->settle.event_flags != NULL)
+        osEventFlagsClear(hctrl->settle.event_flags,
+                          hctrl->settle.settled_flag | hctrl->settle.timeout_flag);
+#endif
+    hctrl->settle.done = false;
+}
+
+/**
+ * 注册就位事件回调
+ * @param hctrl 受控对象
+ * @param callback 回调，NULL 表示取消
+ */
+void Motor_PosCtrl_RegisterSettleCallback(Motor_PosCtrl_t*             hctrl,
+                                          const Motor_SettleCallback_t callback)
+{
+    hctrl->settle.callback = callback;
+}
+
+#ifdef USE_RTOS
+/**
+ * 设置就位事件标志
+ *
+ * 任务中可以通过 osEventFlagsWait 阻塞等待就位或超时，而不必轮询 Motor_PosCtrl_IsSettle
+ * @param hctrl 受控对象
+ * @param event_flags 事件标志组，NULL 表示取消
+ * @param settled_flag 就位时置位的标志
+ * @param timeout_flag 超时时置位的标志
+ */
+void Motor_PosCtrl_SetSettleEventFlags(Motor_PosCtrl_t* hctrl,
+                                       const osEventFlagsId_t event_flags,
+                                       const uint32_t         settled_flag,
+                                       const uint32_t         timeout_flag)
+{
+    hctrl->settle.event_flags  = event_flags;
+    hctrl->settle.settled_flag = settled_flag;
+    hctrl->settle.timeout_flag = timeout_flag;
+}
+#endif
+
+/**
+ * 读取 PID 当前参数
+ */
+static MotorPID_Config_t pid_get_config(const MotorPID_t* pid)
+{
+    return (MotorPID_Config_t) {
+        .Kp             = pid->Kp,
+        .Ki             = pid->Ki,
+        .Kd             = pid->Kd,
+        .abs_output_max = pid->abs_output_max,
+    };
+}
+
+/**
+ * 应用新的 PID 参数，保留运行状态
+ *
+ * MotorPID_t 为增量式，积分作用累积在 output 中，修改参数不会改变当前输出，不需要对积分重新缩放，
+ * 仅在限幅减小时将输出收回到新的限幅内
+ * @note 依赖 MotorPID_t 为增量式 (状态只有两拍历史误差和累积的 output，没有单独的积分项)，
+ *       若改为位置式，需要在此按 Ki_old / Ki_new 缩放积分累加量
+ */
+static void pid_retune(MotorPID_t* pid, const MotorPID_Config_t* config)
+{
+    const float max = config->abs_output_max;
+
+    pid->Kp             = config->Kp;
+    pid->Ki             = config->Ki;
+    pid->Kd             = config->Kd;
+    pid->abs_output_max = max;
+    pid->output         = pid->output > max ? max : pid->output;
+    pid->output         = pid->output < -max ? -max : pid->output;
+}
+
+/**
+ * 开始位置环在线调参
+ *
+ * 返回任务侧的缓冲，内容预置为最新的参数，修改后调用 Motor_PosCtrl_PublishTune 发布。
+ * 同一控制对象只应在一个任务中调参；启用增益调度时 Kp, Ki, Kd 由调度表决定，仅限幅生效
+ * @param hctrl 受控对象
+ * @return 可写入的参数块
+ */
+Motor_PosCtrlParams_t* Motor_PosCtrl_BeginTune(Motor_PosCtrl_t* hctrl)
+{
+    Motor_PosCtrlParams_t*       params  = &hctrl->tune.buffer[hctrl->tune.back];
+    const Motor_PosCtrlParams_t* pending = hctrl->tune.pending;
+
+    if (pending != NULL)
+        *params = *pending;
+    else
+    {
+        params->velocity_pid = pid_get_config(&hctrl->velocity_pid);
+        params->position_pid = pid_get_config(&hctrl->position_pid);
+    }
+    return params;
+}
+
+/**
+ * 发布位置环参数，下一次控制更新时生效
+ *
+ * 发布只是一次指针写入，控制更新不会读到写了一半的参数；
+ * 发布后任务侧切换到另一块缓冲，不会改写尚未被取用的参数块
+ * @param hctrl 受控对象
+ */
+void Motor_PosCtrl_PublishTune(Motor_PosCtrl_t* hctrl)
+{
+    __DMB(); // 保证参数块的写入先于指针发布
+    hctrl->tune.pending = &hctrl->tune.buffer[hctrl->tune.back];
+    hctrl->tune.back ^= 1U;
+}
+
+/**
+ * 开始速度环在线调参，用法同 Motor_PosCtrl_BeginTune
+ * @param hctrl 受控对象
+ * @return 可写入的参数块
+ */
+Motor_VelCtrlParams_t* Motor_VelCtrl_BeginTune(Motor_VelCtrl_t* hctrl)
+{
+    Motor_VelCtrlParams_t*       params  = &hctrl->tune.buffer[hctrl->tune.back];
+    const Motor_VelCtrlParams_t* pending = hctrl->tune.pending;
+
+    if (pending != NULL)
+        *params = *pending;
+    else
+        params->pid = pid_get_config(&hctrl->pid);
+    return params;
+}
+
+/**
+ * 发布速度环参数，下一次控制更新时生效
+ * @param hctrl 受控对象
+ */
+void Motor_VelCtrl_PublishTune(Motor_VelCtrl_t* hctrl)
+{
+    __DMB(); // 保证参数块的写入先于指针发布
+    hctrl->tune.pending = &hctrl->tune.buffer[hctrl->tune.back];
+    hctrl->tune.back ^= 1U;
+}
+
+/**
+ * 位置环控制计算的一步，不访问电机
+ *
+ * 反馈由调用者读取，计算结果以指令形式返回，由调用者下发。
+ * C 接口通过操作表读取和下发，C++ 接口 (motor_if.hpp) 在编译期确定电机类型后直接内联调用
+ * @param hctrl 受控对象
+ * @param state 电机反馈
+ * @return 需要下发的指令
+ */
+Motor_Cmd_t Motor_PosCtrl_Step(Motor_PosCtrl_t* hctrl, const Motor_State_t* state)
+{
+    const Motor_PosCtrlParams_t* params = hctrl->tune.pending;
+    if (params != NULL)
+    {
+        hctrl->tune.pending = NULL;
+        pid_retune(&hctrl->velocity_pid, &params->velocity_pid);
+        pid_retune(&hctrl->position_pid, &params->position_pid);
+    }
+
+    ++hctrl->count;
+
+    // 误差先在定点下计算再转为 float，精度与转过的距离无关
+    const float error        = MotorPos_DiffDeg(MotorPos_Load(&hctrl->target), state->pos);
+    const float abs_error    = fabsf(error);
+    const float abs_velocity = fabsf(state->velocity);
+
+    motor_posctrl_settle_update(hctrl, abs_error, abs_velocity);
+
 #ifdef MOTOR_IF_INTERNAL_VEL_POS
     if (hctrl->ctrl_mode == MOTOR_CTRL_INTERNAL_VEL_POS)
     {
-        motor_send_internal_position(hctrl->motor_type, hctrl->motor, hctrl->position);
         hctrl->count = 0;
-        return;
+        if (tx_policy_check(&hctrl->tx, hctrl->position))
+            return (Motor_Cmd_t) { MOTOR_CMD_POSITION, hctrl->position };
+        return (Motor_Cmd_t) { MOTOR_CMD_NONE, 0.0f };
     }
 #endif
 
     if (hctrl->count == hctrl->pos_vel_freq_ratio)
     {
-        hctrl->position_pid.ref = hctrl->position;
-        // 反馈为当前电机输出角度
-        hctrl->position_pid.fdb = angle;
+        // 以误差为目标、0 为反馈，避免大角度时 ref 与 fdb 在 float 下相减损失精度
+        hctrl->position_pid.ref = error;
+        hctrl->position_pid.fdb = 0.0f;
+        gain_sched_apply(&hctrl->gain_sched.position,
+                         &hctrl->position_pid,
+                         abs_velocity,
+                         abs_error);
         MotorPID_Calculate(&hctrl->position_pid);
         hctrl->count = 0;
     }
@@ -298,15 +1032,108 @@ void Motor_PosCtrlUpdate(Motor_PosCtrl_t* hctrl)
 #ifdef MOTOR_IF_INTERNAL_VEL
     if (hctrl->ctrl_mode == MOTOR_CTRL_INTERNAL_VEL)
     {
-        motor_send_internal_velocity(hctrl->motor_type, hctrl->motor, hctrl->position_pid.output);
-        return;
+        const float velocity = hctrl->position_pid.output + hctrl->feedforward.velocity;
+        if (tx_policy_check(&hctrl->tx, velocity))
+            return (Motor_Cmd_t) { MOTOR_CMD_VELOCITY, velocity };
+        return (Motor_Cmd_t) { MOTOR_CMD_NONE, 0.0f };
     }
 #endif
 
-    hctrl->velocity_pid.ref = hctrl->position_pid.output;
-    hctrl->velocity_pid.fdb = Motor_GetVelocity(hctrl->motor_type, hctrl->motor);
+    hctrl->velocity_pid.ref = hctrl->position_pid.output + hctrl->feedforward.velocity;
+    hctrl->velocity_pid.fdb = state->velocity;
+    gain_sched_apply(&hctrl->gain_sched.velocity, &hctrl->velocity_pid, abs_velocity, abs_error);
     MotorPID_Calculate(&hctrl->velocity_pid);
-    motor_apply_output(hctrl->motor_type, hctrl->motor, hctrl->velocity_pid.output);
+
+    // 前馈不进入 PID 状态，仅叠加在下发的输出上
+    const float ff_velocity = hctrl->feedforward.velocity;
+    const float friction    = ff_velocity > 0   ? hctrl->feedforward.friction
+                              : ff_velocity < 0 ? -hctrl->feedforward.friction
+                                                : 0.0f;
+    const float max         = hctrl->velocity_pid.abs_output_max;
+
+    float output = hctrl->velocity_pid.output +
+                   hctrl->feedforward.inertia * hctrl->feedforward.acceleration + friction +
+                   hctrl->feedforward.torque;
+    output = output > max ? max : output;
+    output = output < -max ? -max : output;
+    return (Motor_Cmd_t) { MOTOR_CMD_OUTPUT, output };
+}
+
+/**
+ * 通过操作表下发指令
+ */
+static void motor_apply_cmd(const Motor_Ops_t* ops, void* motor, const Motor_Cmd_t cmd)
+{
+    switch (cmd.type)
+    {
+    case MOTOR_CMD_OUTPUT:
+        ops->apply_output(motor, cmd.value);
+        break;
+    case MOTOR_CMD_VELOCITY:
+        ops->send_velocity(motor, cmd.value);
+        break;
+    case MOTOR_CMD_POSITION:
+        ops->send_position(motor, cmd.value);
+        break;
+    default:;
+    }
+}
+
+/**
+ * 位置环控制计算
+ * @param hctrl 受控对象
+ */
+void Motor_PosCtrlUpdate(Motor_PosCtrl_t* hctrl)
+{
+    if (!hctrl->enable)
+        return;
+
+    PROFILE_BEGIN();
+    const Motor_State_t state = hctrl->ops->get_state(hctrl->motor);
+    motor_apply_cmd(hctrl->ops, hctrl->motor, Motor_PosCtrl_Step(hctrl, &state));
+    PROFILE_END(&hctrl->profile);
+}
+
+/**
+ * 速度环控制计算的一步，不访问电机，用法同 Motor_PosCtrl_Step
+ * @param hctrl 受控对象
+ * @param velocity 电机转速反馈 (unit: rpm)
+ * @return 需要下发的指令
+ */
+Motor_Cmd_t Motor_VelCtrl_Step(Motor_VelCtrl_t* hctrl, const float velocity)
+{
+    const Motor_VelCtrlParams_t* params = hctrl->tune.pending;
+    if (params != NULL)
+    {
+        hctrl->tune.pending = NULL;
+        pid_retune(&hctrl->pid, &params->pid);
+    }
+
+#if defined(MOTOR_IF_INTERNAL_VEL_POS) || defined(MOTOR_IF_INTERNAL_VEL)
+    switch (hctrl->ctrl_mode)
+    {
+#    ifdef MOTOR_IF_INTERNAL_VEL_POS
+    case MOTOR_CTRL_INTERNAL_VEL_POS:
+#    endif
+#    ifdef MOTOR_IF_INTERNAL_VEL
+    case MOTOR_CTRL_INTERNAL_VEL:
+#    endif
+        if (tx_policy_check(&hctrl->tx, hctrl->velocity))
+            return (Motor_Cmd_t) { MOTOR_CMD_VELOCITY, hctrl->velocity };
+        return (Motor_Cmd_t) { MOTOR_CMD_NONE, 0.0f };
+    default:;
+    }
+#endif
+
+    hctrl->pid.ref = hctrl->velocity;
+    hctrl->pid.fdb = velocity;
+    gain_sched_apply(&hctrl->gain_sched,
+                     &hctrl->pid,
+                     fabsf(hctrl->pid.fdb),
+                     fabsf(hctrl->pid.ref - hctrl->pid.fdb));
+    MotorPID_Calculate(&hctrl->pid);
+
+    return (Motor_Cmd_t) { MOTOR_CMD_OUTPUT, hctrl->pid.output };
 }
 
 /**
@@ -318,27 +1145,248 @@ void Motor_VelCtrlUpdate(Motor_VelCtrl_t* hctrl)
     if (!hctrl->enable)
         return;
 
-#if defined(MOTOR_IF_INTERNAL_VEL)
-    if (hctrl->ctrl_mode == MOTOR_CTRL_INTERNAL_VEL)
+    PROFILE_BEGIN();
+    const float velocity = hctrl->ops->get_velocity(hctrl->motor);
+    motor_apply_cmd(hctrl->ops, hctrl->motor, Motor_VelCtrl_Step(hctrl, velocity));
+    PROFILE_END(&hctrl->profile);
+}
+
+/**
+ * 电流 (力矩) 控制计算的一步，对目标电流做限幅和限速，不访问电机
+ * @param hctrl 受控对象
+ * @return 需要下发的电流 (unit: 原生电流单位)
+ */
+float Motor_CurCtrl_Step(Motor_CurCtrl_t* hctrl)
+{
+    const float max = hctrl->abs_current_max;
+
+    float current = hctrl->current;
+    if (max > 0)
+    { // 未设置限幅时仅由驱动按满量程限幅
+        current = current > max ? max : current;
+        current = current < -max ? -max : current;
+    }
+
+    if (hctrl->rate_limit > 0)
+    {
+        const float step = current - hctrl->output;
+        if (step > hctrl->rate_limit)
+            current = hctrl->output + hctrl->rate_limit;
+        else if (step < -hctrl->rate_limit)
+            current = hctrl->output - hctrl->rate_limit;
+    }
+
+    hctrl->output = current;
+    return current;
+}
+
+/**
+ * 电流 (力矩) 控制计算
+ *
+ * 对目标电流做限幅和限速后直接下发
+ * @param hctrl 受控对象
+ */
+void Motor_CurCtrlUpdate(Motor_CurCtrl_t* hctrl)
+{
+    if (!hctrl->enable)
+        return;
+
+    PROFILE_BEGIN();
+    hctrl->ops->apply_current(hctrl->motor, Motor_CurCtrl_Step(hctrl));
+    PROFILE_END(&hctrl->profile);
+}
+
+/**
+ * 将源 PID 的运行状态 (积分、历史误差、输出) 交接给目标 PID，保留目标 PID 的参数
+ */
+static void pid_handover(MotorPID_t* dst, const MotorPID_t* src)
+{
+    const float Kp             = dst->Kp;
+    const float Ki             = dst->Ki;
+    const float Kd             = dst->Kd;
+    const float abs_output_max = dst->abs_output_max;
+
+    *dst                = *src;
+    dst->Kp             = Kp;
+    dst->Ki             = Ki;
+    dst->Kd             = Kd;
+    dst->abs_output_max = abs_output_max;
+}
+
+/**
+ * 清空 PID 运行状态，并将目标、反馈和输出预置为给定值，保留参数
+ */
+static void pid_preset(MotorPID_t* pid, const float ref, const float output)
+{
+    const float Kp             = pid->Kp;
+    const float Ki             = pid->Ki;
+    const float Kd             = pid->Kd;
+    const float abs_output_max = pid->abs_output_max;
+
+    memset(pid, 0, sizeof(MotorPID_t));
+    pid->Kp             = Kp;
+    pid->Ki             = Ki;
+    pid->Kd             = Kd;
+    pid->abs_output_max = abs_output_max;
+    pid->ref            = ref;
+    pid->fdb            = ref;
+    pid->output         = output;
+}
+
+/**
+ * 初始化控制仲裁器
+ * @param arbiter 仲裁器
+ */
+void Motor_CtrlArbiter_Init(Motor_CtrlArbiter_t* arbiter)
+{
+    arbiter->owner      = MOTOR_CTRL_OWNER_NONE;
+    arbiter->active.pos = NULL;
+}
+
+/**
+ * 关闭当前控制对象
+ */
+static void arbiter_release(Motor_CtrlArbiter_t* arbiter)
+{
+    switch (arbiter->owner)
     {
-        motor_send_internal_velocity(hctrl->motor_type, hctrl->motor, hctrl->velocity);
+    case MOTOR_CTRL_OWNER_POS:
+        arbiter->active.pos->enable = false;
+        break;
+    case MOTOR_CTRL_OWNER_VEL:
+        arbiter->active.vel->enable = false;
+        break;
+    default:;
+    }
+    arbiter->owner      = MOTOR_CTRL_OWNER_NONE;
+    arbiter->active.pos = NULL;
+}
+
+/**
+ * 切换到位置环控制对象
+ *
+ * 新控制对象的目标位置取当前角度，速度环继承旧控制对象的速度环状态，
+ * 位置环输出预置为当前速度指令，切换前后电机输出连续
+ * @note 就位判断的重置 (RTOS 下会清除事件标志) 在临界区之外进行，此时新控制对象尚未启用；
+ *       期间若有其他上下文抢先切换，本次切换放弃，新控制对象保持关闭
+ * @param arbiter 仲裁器
+ * @param hctrl 位置环控制对象
+ */
+void Motor_CtrlArbiter_SwitchToPos(Motor_CtrlArbiter_t* arbiter, Motor_PosCtrl_t* hctrl)
+{
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (arbiter->owner == MOTOR_CTRL_OWNER_POS && arbiter->active.pos == hctrl)
+    {
+        __set_PRIMASK(primask);
         return;
     }
-#endif
 
-#if defined(MOTOR_IF_INTERNAL_VEL_POS)
-    if (hctrl->ctrl_mode == MOTOR_CTRL_INTERNAL_VEL_POS)
+    const Motor_State_t state    = hctrl->ops->get_state(hctrl->motor);
+    float               velocity = state.velocity;
+
+    switch (arbiter->owner)
     {
-        motor_send_internal_velocity(hctrl->motor_type, hctrl->motor, hctrl->velocity);
+    case MOTOR_CTRL_OWNER_POS:
+        velocity = arbiter->active.pos->position_pid.output +
+                   arbiter->active.pos->feedforward.velocity;
+        pid_handover(&hctrl->velocity_pid, &arbiter->active.pos->velocity_pid);
+        break;
+    case MOTOR_CTRL_OWNER_VEL:
+        velocity = arbiter->active.vel->velocity;
+        pid_handover(&hctrl->velocity_pid, &arbiter->active.vel->pid);
+        break;
+    default:
+        pid_preset(&hctrl->velocity_pid, state.velocity, 0.0f);
+        break;
+    }
+    arbiter_release(arbiter);
+
+    hctrl->enable   = false; // 切换完成前保持关闭，控制更新不会访问就位状态
+    hctrl->position = state.angle;
+    MotorPos_Store(&hctrl->target, state.pos);
+    pid_preset(&hctrl->position_pid, 0.0f, velocity);
+    hctrl->count = 0;
+
+    hctrl->feedforward.velocity     = 0.0f;
+    hctrl->feedforward.acceleration = 0.0f;
+    hctrl->feedforward.torque       = 0.0f;
+
+    __set_PRIMASK(primask);
+
+    // osEventFlagsClear 不能在屏蔽中断时调用
+    Motor_PosCtrl_ResetSettle(hctrl);
+
+    __disable_irq();
+    if (arbiter->owner != MOTOR_CTRL_OWNER_NONE)
+    {
+        // 已被其他上下文接管
+        __set_PRIMASK(primask);
         return;
     }
-#endif
+    hctrl->tx.sent      = false;
+    arbiter->owner      = MOTOR_CTRL_OWNER_POS;
+    arbiter->active.pos = hctrl;
+    hctrl->enable       = true;
 
-    hctrl->pid.ref = hctrl->velocity;
-    hctrl->pid.fdb = Motor_GetVelocity(hctrl->motor_type, hctrl->motor);
-    MotorPID_Calculate(&hctrl->pid);
+    __set_PRIMASK(primask);
+}
+
+/**
+ * 切换到速度环控制对象
+ *
+ * 新控制对象的目标速度取旧控制对象的当前速度指令，速度环继承旧控制对象的速度环状态
+ * @param arbiter 仲裁器
+ * @param hctrl 速度环控制对象
+ */
+void Motor_CtrlArbiter_SwitchToVel(Motor_CtrlArbiter_t* arbiter, Motor_VelCtrl_t* hctrl)
+{
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (arbiter->owner == MOTOR_CTRL_OWNER_VEL && arbiter->active.vel == hctrl)
+    {
+        __set_PRIMASK(primask);
+        return;
+    }
 
-    motor_apply_output(hctrl->motor_type, hctrl->motor, hctrl->pid.output);
+    switch (arbiter->owner)
+    {
+    case MOTOR_CTRL_OWNER_POS:
+        hctrl->velocity = arbiter->active.pos->position_pid.output +
+                          arbiter->active.pos->feedforward.velocity;
+        pid_handover(&hctrl->pid, &arbiter->active.pos->velocity_pid);
+        break;
+    case MOTOR_CTRL_OWNER_VEL:
+        hctrl->velocity = arbiter->active.vel->velocity;
+        pid_handover(&hctrl->pid, &arbiter->active.vel->pid);
+        break;
+    default:
+        hctrl->velocity = hctrl->ops->get_velocity(hctrl->motor);
+        pid_preset(&hctrl->pid, hctrl->velocity, 0.0f);
+        break;
+    }
+    arbiter_release(arbiter);
+
+    hctrl->tx.sent      = false;
+    arbiter->owner      = MOTOR_CTRL_OWNER_VEL;
+    arbiter->active.vel = hctrl;
+    hctrl->enable       = true;
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * 释放电机，关闭当前控制对象
+ * @param arbiter 仲裁器
+ */
+void Motor_CtrlArbiter_Release(Motor_CtrlArbiter_t* arbiter)
+{
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    arbiter_release(arbiter);
+    __set_PRIMASK(primask);
 }
 
 #ifdef __cplusplus
@@ -34,7 +34,13 @@
 #define __MOTOR_IF_VERSION__ "2.0.0"
 
 #include <stdbool.h>
+#include <stddef.h>
 #include "libs/pid_motor.h"
+#include "bsp/cycle_profiler.h"
+#include "bsp/motor_pos.h"
+#ifdef USE_RTOS
+#    include "cmsis_os2.h"
+#endif
 
 // 希望在初始化时手动决定控制模式请启用以下宏
 // #define USE_CUSTOM_CTRL_MODE
@@ -49,8 +55,7 @@
  *      #define MOTOR_IF_INTERNAL_VEL_POS
  * 3. 在 MotorType_t 里增加条件编译的电机类型
  * 4. 通过宏定义新增 电机控制模式 默认值
- * 5. 实现 Motor_GetAngle
- * 6. 实现 Motor_GetVelocity
+ * 之后在 motor_if.c 中实现该电机的 Motor_Ops_t
  ****************************************/
 
 // #define USE_DJI
@@ -95,6 +100,8 @@ typedef enum
 #ifdef USE_DM
     MOTOR_TYPE_DM,
 #endif
+
+    MOTOR_TYPE_COUNT
 } MotorType_t;
 /**
  * 电机控制模式
@@ -130,28 +137,309 @@ typedef enum
 #endif
 
 /**
- * 位置环控制对象
+ * 电机反馈量
+ */
+typedef struct
+{
+    float      angle;    ///< 电机轴输出角度 (unit: deg)
+    float      velocity; ///< 电机轴输出转速 (unit: rpm)
+    MotorPos_t pos;      ///< 电机轴输出位置 (定点)，位置环以此计算误差
+} Motor_State_t;
+
+/**
+ * 电机操作表
+ *
+ * 每种电机提供一张常量操作表，控制对象在初始化时绑定，之后的访问都是一次间接调用
+ * 不支持的操作为空操作，而不是 NULL
+ */
+typedef struct
+{
+    Motor_State_t (*get_state)(void* motor);            ///< 获取角度、转速和定点位置
+    float (*get_angle)(void* motor);                    ///< 获取角度 (unit: deg)
+    float (*get_velocity)(void* motor);                 ///< 获取转速 (unit: rpm)
+    MotorPos_t (*get_pos)(void* motor);                 ///< 获取定点位置
+    void (*apply_output)(void* motor, float output);    ///< 应用电流 (或占空比)
+    void (*send_velocity)(void* motor, float velocity); ///< 发送内部速度指令 (unit: rpm)
+    void (*send_position)(void* motor, float position); ///< 发送内部位置指令 (unit: deg)
+    void (*apply_current)(void* motor, float current);  ///< 电流 (力矩) 指令，见 Motor_CurCtrl_t
+    void (*reset_angle)(void* motor);                   ///< 清零角度
+    MotorCtrlMode_t default_ctrl_mode;                  ///< 默认控制模式
+} Motor_Ops_t;
+
+const Motor_Ops_t* Motor_GetOps(MotorType_t motor_type);
+
+/**
+ * 控制指令类型
+ */
+typedef enum
+{
+    MOTOR_CMD_NONE = 0U, ///< 无需下发 (被发送策略抑制)
+    MOTOR_CMD_OUTPUT,    ///< 电流 (或占空比) 输出，对应 apply_output
+    MOTOR_CMD_VELOCITY,  ///< 内部速度指令，对应 send_velocity (unit: rpm)
+    MOTOR_CMD_POSITION,  ///< 内部位置指令，对应 send_position (unit: deg)
+} Motor_CmdType_t;
+
+/**
+ * 一次控制计算得到的指令
  */
 typedef struct
 {
-    bool            enable;             ///< 是否启用控制
-    MotorType_t     motor_type;         ///< 受控电机类型
-    MotorCtrlMode_t ctrl_mode;          ///< 控制模式
-    void*           motor;              ///< 受控电机
-    MotorPID_t      velocity_pid;       ///< 内环，速度环
-    MotorPID_t      position_pid;       ///< 外环，位置环
-    uint32_t        pos_vel_freq_ratio; ///< 内外环频率比
-    uint32_t        count;              ///< 计数
-    float           position;           ///< 当前控制的位置
+    Motor_CmdType_t type;  ///< 指令类型
+    float           value; ///< 指令值
+} Motor_Cmd_t;
+
+/**
+ * 电机注册表容量
+ */
+#ifndef MOTOR_REGISTRY_MAX
+#    define MOTOR_REGISTRY_MAX (32U)
+#endif
+
+/**
+ * 注册表中不同总线的数量上限
+ */
+#ifndef MOTOR_REGISTRY_BUS_MAX
+#    define MOTOR_REGISTRY_BUS_MAX (4U)
+#endif
+
+/**
+ * 不挂在总线上的电机 (如 TB6612) 的总线编号
+ */
+#define MOTOR_BUS_NONE (0xFFU)
+
+/**
+ * 电机句柄
+ *
+ * 由注册函数返回，电机类型在注册时由参数类型确定，总线取自电机驱动结构体中的 CAN 实例；
+ * 之后通过句柄取得的电机指针与类型都以注册表中的记录为准，与记录不一致的句柄视为无效
+ */
+typedef struct
+{
+    uint8_t  bus;   ///< 总线编号，按 CAN 实例首次注册的顺序分配，MOTOR_BUS_NONE 表示无总线
+    uint8_t  type;  ///< 电机类型 (MotorType_t)
+    uint16_t index; ///< 注册表下标
+} Motor_Handle_t;
+
+/**
+ * 无效句柄，注册失败时返回
+ */
+#define MOTOR_HANDLE_INVALID ((Motor_Handle_t) { MOTOR_BUS_NONE, MOTOR_TYPE_COUNT, 0xFFFFU })
+
+#ifdef USE_DJI
+Motor_Handle_t Motor_Register_DJI(DJI_t* hdji);
+#endif
+#ifdef USE_TB6612
+Motor_Handle_t Motor_Register_TB6612(TB6612_t* htb6612);
+#endif
+#ifdef USE_VESC
+Motor_Handle_t Motor_Register_VESC(VESC_t* hvesc);
+#endif
+#ifdef USE_DM
+Motor_Handle_t Motor_Register_DM(DM_t* hdm);
+#endif
+
+size_t         Motor_Registry_Count(void);
+Motor_Handle_t Motor_Registry_Get(size_t index);
+bool           Motor_Registry_Contains(Motor_Handle_t handle);
+MotorType_t    Motor_Registry_GetType(Motor_Handle_t handle);
+void*          Motor_Registry_GetMotor(Motor_Handle_t handle);
+void*          Motor_Registry_GetMotorAs(Motor_Handle_t handle, MotorType_t motor_type);
+const void*    Motor_Registry_GetBus(Motor_Handle_t handle);
+
+/**
+ * 判断句柄是否有效
+ * @param handle 句柄
+ * @return 是否与注册表中的记录一致
+ */
+static inline bool Motor_Handle_IsValid(const Motor_Handle_t handle)
+{
+    return Motor_Registry_Contains(handle);
+}
+
+/**
+ * 获取句柄对应电机的操作表
+ * @note 按注册表中记录的类型选择，而不是句柄副本中的类型
+ * @param handle 句柄
+ * @return 操作表，无效句柄返回空操作表
+ */
+static inline const Motor_Ops_t* Motor_Handle_GetOps(const Motor_Handle_t handle)
+{
+    return Motor_GetOps(Motor_Registry_GetType(handle));
+}
+
+/**
+ * 读取句柄对应电机的反馈
+ * @param handle 句柄
+ * @return 角度和转速
+ */
+static inline Motor_State_t Motor_Handle_GetState(const Motor_Handle_t handle)
+{
+    return Motor_Handle_GetOps(handle)->get_state(Motor_Registry_GetMotor(handle));
+}
+
+/**
+ * 在控制对象配置中使用句柄，同时填写 motor_type 和 motor，避免两者不匹配
+ * 类型和电机都取自注册表，无效句柄得到 MOTOR_TYPE_COUNT 和 NULL
+ *
+ * 例: &(Motor_PosCtrlConfig_t) { MOTOR_HANDLE_CONFIG(handle), .velocity_pid = ... }
+ */
+#define MOTOR_HANDLE_CONFIG(__HANDLE__)                                                            \
+    .motor_type = Motor_Registry_GetType(__HANDLE__), .motor = Motor_Registry_GetMotor(__HANDLE__)
+
+/**
+ * 内部环指令发送策略
+ *
+ * 指令变化超过死区时立即发送，否则只在保活间隔到达时重发，避免恒定目标每周期重复占用总线。
+ * 保活间隔应小于电调的指令超时时间
+ */
+typedef struct
+{
+    float    deadband;     ///< 变化死区，0 表示任何变化都发送
+    uint32_t keepalive_ms; ///< 保活间隔 (unit: ms)，0 表示每次更新都发送
+    float    last_value;   ///< 上一次发送的值
+    uint32_t last_tick;    ///< 上一次发送的时刻 (unit: ms)
+    bool     sent;         ///< 是否发送过
+} Motor_TxPolicy_t;
+
+/**
+ * 增益调度变量
+ */
+typedef enum
+{
+    MOTOR_GAIN_SCHED_NONE = 0U, ///< 不使用增益调度，保持配置中的参数
+    MOTOR_GAIN_SCHED_VELOCITY,  ///< 电机转速绝对值 (unit: rpm)
+    MOTOR_GAIN_SCHED_ERROR,     ///< 误差绝对值，位置环控制对象为位置误差，速度环控制对象为速度误差
+    MOTOR_GAIN_SCHED_USER,      ///< 用户给定的标量，如负载质量，见 Motor_*Ctrl_SetGainSchedInput
+} Motor_GainSchedKey_t;
+
+/**
+ * 增益调度断点
+ */
+typedef struct
+{
+    float x;  ///< 调度变量取值
+    float Kp; ///< 该点的比例系数
+    float Ki; ///< 该点的积分系数
+    float Kd; ///< 该点的微分系数
+} Motor_GainPoint_t;
+
+/**
+ * 增益调度表配置
+ */
+typedef struct
+{
+    Motor_GainSchedKey_t     key;    ///< 调度变量
+    const Motor_GainPoint_t* points; ///< 断点表，按 x 升序排列，由调用者保证生命周期
+    size_t                   count;  ///< 断点数
+} Motor_GainSchedConfig_t;
+
+/**
+ * 增益调度表
+ *
+ * 每次 PID 计算前按调度变量在相邻断点间线性插值得到 Kp, Ki, Kd，超出断点范围时取端点值
+ */
+typedef struct
+{
+    Motor_GainSchedKey_t     key;    ///< 调度变量
+    const Motor_GainPoint_t* points; ///< 断点表
+    size_t                   count;  ///< 断点数
+    size_t                   index;  ///< 上次所在区间，调度变量连续变化时查找为 O(1)
+    float                    input;  ///< 用户给定的调度变量，仅 MOTOR_GAIN_SCHED_USER 时有效
+} Motor_GainSched_t;
+
+/**
+ * 就位事件
+ */
+typedef enum
+{
+    MOTOR_SETTLE_EVENT_SETTLED = 0U, ///< 就位
+    MOTOR_SETTLE_EVENT_TIMEOUT,      ///< 超时仍未就位
+} Motor_SettleEvent_t;
+
+typedef struct Motor_PosCtrl Motor_PosCtrl_t;
+
+/**
+ * 位置环在线调参参数块
+ */
+typedef struct
+{
+    MotorPID_Config_t velocity_pid; ///< 内环参数
+    MotorPID_Config_t position_pid; ///< 外环参数
+} Motor_PosCtrlParams_t;
+
+/**
+ * 速度环在线调参参数块
+ */
+typedef struct
+{
+    MotorPID_Config_t pid; ///< 速度环参数
+} Motor_VelCtrlParams_t;
+
+/**
+ * 就位事件回调，在控制更新 (一般为定时器中断) 中调用，不应阻塞
+ */
+typedef void (*Motor_SettleCallback_t)(Motor_PosCtrl_t* hctrl, Motor_SettleEvent_t event);
+
+/**
+ * 位置环控制对象
+ */
+struct Motor_PosCtrl
+{
+    bool               enable;             ///< 是否启用控制
+    MotorType_t        motor_type;         ///< 受控电机类型
+    const Motor_Ops_t* ops;                ///< 受控电机操作表
+    MotorCtrlMode_t    ctrl_mode;          ///< 控制模式
+    void*              motor;              ///< 受控电机
+    MotorPID_t         velocity_pid;       ///< 内环，速度环
+    MotorPID_t         position_pid;       ///< 外环，位置环
+    uint32_t           pos_vel_freq_ratio; ///< 内外环频率比
+    uint32_t           count;              ///< 计数
+    float              position;           ///< 当前控制的位置 (unit: deg)，仅用于显示和内部位置环
+    MotorPos_t         target;             ///< 当前控制的位置 (定点)，外部位置环以此计算误差
+    Motor_TxPolicy_t   tx;                 ///< 内部环指令发送策略
+
+    struct
+    {
+        float    error_threshold;    ///< 允许的误差范围
+        float    velocity_threshold; ///< 允许的转速范围，0 表示不判断转速 (unit: rpm)
+        uint32_t count_max;          ///< 保持的计数范围
+        uint32_t counter;            ///< 就位计数
+        uint32_t timeout;            ///< 超时计数，0 表示不判断超时
+        uint32_t elapsed;            ///< 设置目标后经过的计数
+        bool     done;               ///< 当前目标的就位事件是否已触发
+
+        Motor_SettleCallback_t callback; ///< 就位事件回调
+#ifdef USE_RTOS
+        osEventFlagsId_t event_flags;  ///< 就位事件标志组
+        uint32_t         settled_flag; ///< 就位时置位的标志
+        uint32_t         timeout_flag; ///< 超时时置位的标志
+#endif
+    } settle; ///< 就位判断
+
+    struct
+    {
+        float velocity;     ///< 速度前馈，叠加到速度环目标 (unit: rpm)
+        float acceleration; ///< 加速度前馈 (unit: rpm/s)
+        float torque;       ///< 力矩前馈，叠加到电流输出 (unit: 电流指令)
+        float inertia;      ///< 惯量增益 (unit: 电流指令 / (rpm/s))
+        float friction;     ///< 摩擦补偿，按速度前馈方向叠加 (unit: 电流指令)
+    } feedforward;          ///< 前馈
 
     struct
     {
-        float    error_threshold; ///< 允许的误差范围
-        uint32_t count_max;       ///< 保持的计数范围
-        uint32_t counter;         ///< 就位计数
-    } settle;                     ///< 就位判断
+        Motor_GainSched_t velocity; ///< 速度环增益调度
+        Motor_GainSched_t position; ///< 位置环增益调度
+    } gain_sched;                   ///< 增益调度
 
-} Motor_PosCtrl_t;
+    struct
+    {
+        Motor_PosCtrlParams_t           buffer[2]; ///< 双缓冲
+        Motor_PosCtrlParams_t* volatile pending;   ///< 已发布、等待下一次更新取用的参数块
+        uint8_t                         back;      ///< 任务侧可写入的缓冲下标
+    } tune; ///< 在线调参
+
+    PROFILE_FIELD(profile) ///< 更新耗时
+};
 
 /**
  * 位置环控制配置
@@ -167,8 +455,19 @@ typedef struct
     MotorPID_Config_t position_pid;
     uint32_t          pos_vel_freq_ratio; ///< 内外环频率比
 
-    float    error_threshold;  ///< 允许的误差范围
-    uint32_t settle_count_max; ///< 在误差内多少周期认为就位
+    float    error_threshold;           ///< 允许的误差范围
+    uint32_t settle_count_max;          ///< 在误差内多少周期认为就位
+    float    settle_velocity_threshold; ///< 就位时允许的转速范围，0 表示不判断转速 (unit: rpm)
+    uint32_t settle_timeout;            ///< 设置目标后多少周期未就位认为超时，0 表示不判断超时
+
+    float    tx_deadband;     ///< 内部环指令变化死区
+    uint32_t tx_keepalive_ms; ///< 内部环指令保活间隔 (unit: ms)，0 表示每次更新都发送
+
+    float ff_inertia;  ///< 加速度前馈增益，不使用时为 0 (unit: 电流指令 / (rpm/s))
+    float ff_friction; ///< 摩擦前馈，不使用时为 0 (unit: 电流指令)
+
+    Motor_GainSchedConfig_t velocity_gain_sched; ///< 速度环增益调度，不使用时为 0
+    Motor_GainSchedConfig_t position_gain_sched; ///< 位置环增益调度，不使用时为 0
 } Motor_PosCtrlConfig_t;
 
 /**
@@ -176,12 +475,24 @@ typedef struct
  */
 typedef struct
 {
-    bool            enable;     //< 是否启用控制
-    MotorType_t     motor_type; //< 受控电机类型
-    MotorCtrlMode_t ctrl_mode;  ///< 控制模式
-    void*           motor;      //< 受控电机
-    MotorPID_t      pid;        //< 速度环
-    float           velocity;   //< 当前控制的速度
+    bool               enable;     //< 是否启用控制
+    MotorType_t        motor_type; //< 受控电机类型
+    const Motor_Ops_t* ops;        ///< 受控电机操作表
+    MotorCtrlMode_t    ctrl_mode;  ///< 控制模式
+    void*              motor;      //< 受控电机
+    MotorPID_t         pid;        //< 速度环
+    float              velocity;   //< 当前控制的速度
+    Motor_TxPolicy_t   tx;         ///< 内部环指令发送策略
+    Motor_GainSched_t  gain_sched; ///< 增益调度
+
+    struct
+    {
+        Motor_VelCtrlParams_t           buffer[2]; ///< 双缓冲
+        Motor_VelCtrlParams_t* volatile pending;   ///< 已发布、等待下一次更新取用的参数块
+        uint8_t                         back;      ///< 任务侧可写入的缓冲下标
+    } tune; ///< 在线调参
+
+    PROFILE_FIELD(profile) ///< 更新耗时
 } Motor_VelCtrl_t;
 
 /**
@@ -195,22 +506,135 @@ typedef struct
 #endif
     void*             motor; //< 受控电机
     MotorPID_Config_t pid;
+
+    float    tx_deadband;     ///< 内部环指令变化死区
+    uint32_t tx_keepalive_ms; ///< 内部环指令保活间隔 (unit: ms)，0 表示每次更新都发送
+
+    Motor_GainSchedConfig_t gain_sched; ///< 增益调度，不使用时为 0
 } Motor_VelCtrlConfig_t;
 
+/**
+ * 电流 (力矩) 控制对象
+ *
+ * 不经过 PID，直接将电流指令下发给电机。各电机的 *原生电流单位* 为
+ *   - DJI: A
+ *   - TB6612: 占空比 (-1 ~ 1)，无电流反馈，近似认为力矩与占空比成正比
+ *   - VESC: A (VESC_CAN_SET_CURRENT)
+ *   - DM: N·m (MIT 模式，Kp = Kd = 0)
+ */
+typedef struct
+{
+    bool               enable;          ///< 是否启用控制
+    MotorType_t        motor_type;      ///< 受控电机类型
+    const Motor_Ops_t* ops;             ///< 受控电机操作表
+    void*              motor;           ///< 受控电机
+    float              torque_constant; ///< 输出轴力矩 / 原生电流单位 (unit: N·m / 原生电流单位)
+    float              abs_current_max; ///< 电流限幅 (unit: 原生电流单位)，0 表示仅由驱动限幅
+    float              rate_limit;      ///< 每次更新允许的最大电流变化量，0 表示不限制
+    float              current;         ///< 目标电流
+    float              output;          ///< 经过限幅和限速后实际下发的电流
+
+    PROFILE_FIELD(profile) ///< 更新耗时
+} Motor_CurCtrl_t;
+
+/**
+ * 电流 (力矩) 控制配置
+ */
+typedef struct
+{
+    MotorType_t motor_type;      ///< 受控电机类型
+    void*       motor;           ///< 受控电机
+    float       torque_constant; ///< 输出轴力矩 / 原生电流单位，需包含减速比
+    float       abs_current_max; ///< 电流限幅 (unit: 原生电流单位)，0 表示仅由驱动限幅
+    float       rate_limit;      ///< 每次更新允许的最大电流变化量，0 表示不限制
+} Motor_CurCtrlConfig_t;
+
 void Motor_PosCtrl_Init(Motor_PosCtrl_t* hctrl, const Motor_PosCtrlConfig_t* config);
 void Motor_VelCtrl_Init(Motor_VelCtrl_t* hctrl, const Motor_VelCtrlConfig_t* config);
+void Motor_CurCtrl_Init(Motor_CurCtrl_t* hctrl, const Motor_CurCtrlConfig_t* config);
 void Motor_PosCtrlUpdate(Motor_PosCtrl_t* hctrl);
 void Motor_VelCtrlUpdate(Motor_VelCtrl_t* hctrl);
+void Motor_CurCtrlUpdate(Motor_CurCtrl_t* hctrl);
+
+Motor_Cmd_t Motor_PosCtrl_Step(Motor_PosCtrl_t* hctrl, const Motor_State_t* state);
+Motor_Cmd_t Motor_VelCtrl_Step(Motor_VelCtrl_t* hctrl, float velocity);
+float       Motor_CurCtrl_Step(Motor_CurCtrl_t* hctrl);
+
+void Motor_PosCtrl_ResetSettle(Motor_PosCtrl_t* hctrl);
+void Motor_PosCtrl_RegisterSettleCallback(Motor_PosCtrl_t*       hctrl,
+                                          Motor_SettleCallback_t callback);
+Motor_PosCtrlParams_t* Motor_PosCtrl_BeginTune(Motor_PosCtrl_t* hctrl);
+void                   Motor_PosCtrl_PublishTune(Motor_PosCtrl_t* hctrl);
+Motor_VelCtrlParams_t* Motor_VelCtrl_BeginTune(Motor_VelCtrl_t* hctrl);
+void                   Motor_VelCtrl_PublishTune(Motor_VelCtrl_t* hctrl);
+
+#ifdef USE_RTOS
+void Motor_PosCtrl_SetSettleEventFlags(Motor_PosCtrl_t* hctrl,
+                                       osEventFlagsId_t event_flags,
+                                       uint32_t         settled_flag,
+                                       uint32_t         timeout_flag);
+#endif
+
+/**
+ * 设置目标电流
+ * @param hctrl 受控对象
+ * @param current 目标电流 (unit: 原生电流单位)
+ */
+static inline void Motor_CurCtrl_SetCurrent(Motor_CurCtrl_t* hctrl, const float current)
+{
+    hctrl->current = current;
+}
+
+/**
+ * 设置目标力矩
+ * @param hctrl 受控对象
+ * @param torque 输出轴目标力矩 (unit: N·m)
+ */
+static inline void Motor_CurCtrl_SetTorque(Motor_CurCtrl_t* hctrl, const float torque)
+{
+    hctrl->current = torque / hctrl->torque_constant;
+}
+
+/**
+ * 当前持有电机的控制对象类型
+ */
+typedef enum
+{
+    MOTOR_CTRL_OWNER_NONE = 0U, ///< 无控制对象
+    MOTOR_CTRL_OWNER_POS,       ///< 位置环控制对象
+    MOTOR_CTRL_OWNER_VEL,       ///< 速度环控制对象
+} Motor_CtrlOwner_t;
+
+/**
+ * 控制仲裁器
+ *
+ * 每个电机一个，记录当前启用的控制对象，保证同一时刻只有一个控制对象在控制电机。
+ * 切换时由仲裁器关闭旧控制对象，并用旧控制对象的状态初始化新控制对象，实现无扰切换
+ */
+typedef struct
+{
+    Motor_CtrlOwner_t owner; ///< 当前控制对象类型
+    union
+    {
+        Motor_PosCtrl_t* pos;
+        Motor_VelCtrl_t* vel;
+    } active; ///< 当前控制对象
+} Motor_CtrlArbiter_t;
+
+void Motor_CtrlArbiter_Init(Motor_CtrlArbiter_t* arbiter);
+void Motor_CtrlArbiter_SwitchToPos(Motor_CtrlArbiter_t* arbiter, Motor_PosCtrl_t* hctrl);
+void Motor_CtrlArbiter_SwitchToVel(Motor_CtrlArbiter_t* arbiter, Motor_VelCtrl_t* hctrl);
+void Motor_CtrlArbiter_Release(Motor_CtrlArbiter_t* arbiter);
 
 /**
  * 启用电机控制
- * @param __CTRL_HANDLE__ 受控对象 (Motor_PosCtrl_t* 或 Motor_VelCtrl_t*)
+ * @param __CTRL_HANDLE__ 受控对象 (Motor_PosCtrl_t*, Motor_VelCtrl_t* 或 Motor_CurCtrl_t*)
  */
 #define __MOTOR_CTRL_ENABLE(__CTRL_HANDLE__) ((__CTRL_HANDLE__)->enable = true)
 
 /**
  * 禁用电机控制
- * @param __CTRL_HANDLE__ 受控对象 (Motor_PosCtrl_t* 或 Motor_VelCtrl_t*)
+ * @param __CTRL_HANDLE__ 受控对象 (Motor_PosCtrl_t*, Motor_VelCtrl_t* 或 Motor_CurCtrl_t*)
  */
 #define __MOTOR_CTRL_DISABLE(__CTRL_HANDLE__) ((__CTRL_HANDLE__)->enable = false)
 
@@ -237,12 +661,20 @@ static inline bool Motor_PosCtrl_IsSettle(Motor_PosCtrl_t* hctrl)
 
 /**
  * 设置位置环目标值
+ *
+ * 仅在目标改变时重新开始就位判断，每个周期重复设置相同目标不会影响就位事件；
+ * 目标不变时需要重新触发事件请调用 Motor_PosCtrl_ResetSettle
  * @param hctrl 受控对象
  * @param ref 目标值 (unit: deg)
  */
 static inline void Motor_PosCtrl_SetRef(Motor_PosCtrl_t* hctrl, const float ref)
 {
-    hctrl->position = ref;
+    const MotorPos_t target = MotorPos_FromDeg(ref);
+    const bool       change = target != MotorPos_Load(&hctrl->target);
+    hctrl->position         = ref;
+    MotorPos_Store(&hctrl->target, target);
+    if (change)
+        Motor_PosCtrl_ResetSettle(hctrl);
 #ifdef MOTOR_IF_INTERNAL_VEL_POS
     if (hctrl->ctrl_mode == MOTOR_CTRL_INTERNAL_VEL_POS)
     { // 在内部位置环控制模式下，需要在设置时立刻同步一次指令
@@ -251,6 +683,69 @@ static inline void Motor_PosCtrl_SetRef(Motor_PosCtrl_t* hctrl, const float ref)
 #endif
 }
 
+/**
+ * 以定点位置设置位置环目标值，目标距离零点很远时 (如连续旋转的机构) 使用，不损失精度
+ *
+ * 与 Motor_PosCtrl_SetRef 相同，仅在目标改变时重新开始就位判断
+ * @param hctrl 受控对象
+ * @param ref 目标值 (定点)
+ */
+static inline void Motor_PosCtrl_SetRefPos(Motor_PosCtrl_t* hctrl, const MotorPos_t ref)
+{
+    const bool change = ref != MotorPos_Load(&hctrl->target);
+    hctrl->position   = MotorPos_ToDeg(ref);
+    MotorPos_Store(&hctrl->target, ref);
+    if (change)
+        Motor_PosCtrl_ResetSettle(hctrl);
+#ifdef MOTOR_IF_INTERNAL_VEL_POS
+    if (hctrl->ctrl_mode == MOTOR_CTRL_INTERNAL_VEL_POS)
+    { // 在内部位置环控制模式下，需要在设置时立刻同步一次指令
+        Motor_PosCtrlUpdate(hctrl);
+    }
+#endif
+}
+
+/**
+ * 设置位置环前馈
+ *
+ * 速度前馈叠加到速度环目标；加速度前馈乘以惯量增益、摩擦补偿与力矩前馈一起叠加到电流输出。
+ * 内部速度环模式下仅速度前馈有效，内部位置环模式下前馈无效
+ * @param hctrl 受控对象
+ * @param velocity 速度前馈 (unit: rpm)
+ * @param acceleration 加速度前馈 (unit: rpm/s)
+ * @param torque 力矩前馈 (unit: 电流指令)
+ */
+static inline void Motor_PosCtrl_SetFeedforward(Motor_PosCtrl_t* hctrl,
+                                                const float      velocity,
+                                                const float      acceleration,
+                                                const float      torque)
+{
+    hctrl->feedforward.velocity     = velocity;
+    hctrl->feedforward.acceleration = acceleration;
+    hctrl->feedforward.torque       = torque;
+}
+
+/**
+ * 设置位置环控制对象的用户调度变量，对速度环和位置环的调度表同时生效
+ * @param hctrl 受控对象
+ * @param input 调度变量
+ */
+static inline void Motor_PosCtrl_SetGainSchedInput(Motor_PosCtrl_t* hctrl, const float input)
+{
+    hctrl->gain_sched.velocity.input = input;
+    hctrl->gain_sched.position.input = input;
+}
+
+/**
+ * 设置速度环控制对象的用户调度变量
+ * @param hctrl 受控对象
+ * @param input 调度变量
+ */
+static inline void Motor_VelCtrl_SetGainSchedInput(Motor_VelCtrl_t* hctrl, const float input)
+{
+    hctrl->gain_sched.input = input;
+}
+
 /**
  * 设置速度环目标值
  * @param hctrl 受控对象
@@ -285,60 +780,17 @@ static inline void Motor_VelCtrl_SetRef(Motor_VelCtrl_t* hctrl, const float ref)
  */
 static inline float Motor_GetAngle(const MotorType_t motor_type, void* hmotor)
 {
-    switch (motor_type)
-    {
-#ifdef USE_DJI
-    case MOTOR_TYPE_DJI:
-        return __DJI_GET_ANGLE(hmotor);
-#endif
-#ifdef USE_TB6612
-    case MOTOR_TYPE_TB6612:
-        return __TB6612_GET_ANGLE(hmotor);
-#endif
-#ifdef USE_VESC
-    case MOTOR_TYPE_VESC:
-        return __VESC_GET_ANGLE(hmotor);
-#endif
-#ifdef USE_DM
-    case MOTOR_TYPE_DM:
-        return __DM_GET_ANGLE(hmotor);
-#endif
-    default:
-        return 0.0f;
-    }
+    return Motor_GetOps(motor_type)->get_angle(hmotor);
 }
 
-#define MotorCtrl_GetAngle(__ctrl__) (Motor_GetAngle((__ctrl__)->motor_type, (__ctrl__)->motor))
+#define MotorCtrl_GetAngle(__ctrl__) ((__ctrl__)->ops->get_angle((__ctrl__)->motor))
 
 static inline void Motor_ResetAngle(const MotorType_t motor_type, void* hmotor)
 {
-    switch (motor_type)
-    {
-#ifdef USE_DJI
-    case MOTOR_TYPE_DJI:
-        DJI_ResetAngle(hmotor);
-        break;
-#endif
-#ifdef USE_TB6612
-    case MOTOR_TYPE_TB6612:
-        __TB6612_RESET_ANGLE(hmotor);
-        break;
-#endif
-#ifdef USE_VESC
-    case MOTOR_TYPE_VESC:
-        VESC_ResetAngle(hmotor);
-        break;
-#endif
-#ifdef USE_DM
-    case MOTOR_TYPE_DM:
-
-        break;
-#endif
-    default:;
-    }
+    Motor_GetOps(motor_type)->reset_angle(hmotor);
 }
 
-#define MotorCtrl_ResetAngle(__ctrl__) (Motor_ResetAngle((__ctrl__)->motor_type, (__ctrl__)->motor))
+#define MotorCtrl_ResetAngle(__ctrl__) ((__ctrl__)->ops->reset_angle((__ctrl__)->motor))
 
 /**
  * 获取电机转速
@@ -348,31 +800,23 @@ static inline void Motor_ResetAngle(const MotorType_t motor_type, void* hmotor)
  */
 static inline float Motor_GetVelocity(const MotorType_t motor_type, void* hmotor)
 {
-    switch (motor_type)
-    {
-#ifdef USE_DJI
-    case MOTOR_TYPE_DJI:
-        return __DJI_GET_VELOCITY(hmotor);
-#endif
-#ifdef USE_TB6612
-    case MOTOR_TYPE_TB6612:
-        return __TB6612_GET_VELOCITY(hmotor);
-#endif
-#ifdef USE_VESC
-    case MOTOR_TYPE_VESC:
-        return __VESC_GET_VELOCITY(hmotor);
-#endif
-#ifdef USE_DM
-    case MOTOR_TYPE_DM:
-        return __DM_GET_VELOCITY(hmotor);
-#endif
-    default:
-        return 0.0f;
-    }
+    return Motor_GetOps(motor_type)->get_velocity(hmotor);
+}
+
+#define MotorCtrl_GetVelocity(__ctrl__) ((__ctrl__)->ops->get_velocity((__ctrl__)->motor))
+
+/**
+ * 获取电机轴输出定点位置
+ * @param motor_type 电机类型
+ * @param hmotor 电机数据
+ * @return 电机轴输出位置 (定点)
+ */
+static inline MotorPos_t Motor_GetPos(const MotorType_t motor_type, void* hmotor)
+{
+    return Motor_GetOps(motor_type)->get_pos(hmotor);
 }
 
-#define MotorCtrl_GetVelocity(__ctrl__)                                                            \
-    (Motor_GetVelocity((__ctrl__)->motor_type, (__ctrl__)->motor))
+#define MotorCtrl_GetPos(__ctrl__) ((__ctrl__)->ops->get_pos((__ctrl__)->motor))
 
 #ifdef __cplusplus
 }
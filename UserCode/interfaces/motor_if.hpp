@@ -0,0 +1,329 @@
+/**
+ * @file    motor_if.hpp
+ * @author  syhanjin
+ * @date    2026-10-17
+ * @brief   header-only C++ facade of motor_if with compile-time motor dispatch
+ *
+ * C 接口通过 void* motor + Motor_Ops_t 操作表在运行时分派，C++ 接口在编译期确定电机类型：
+ *   - MotorTraits<M> 描述电机 M 的反馈读取和指令下发，全部内联
+ *   - PosCtrl<M> / VelCtrl<M> / CurCtrl<M> 包装对应的 C 控制对象，
+ *     控制计算复用 Motor_*Ctrl_Step，反馈读取和指令下发经 MotorTraits<M> 静态调用
+ *
+ * 包装类只有一个成员，即对应的 C 结构体，内存布局与 C 结构体一致，
+ * 可以通过 c() 取得 C 指针交给调度器、执行器、仲裁器等 C 接口使用
+ *
+ * --------------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Project repository: https://github.com/HITSZ-WTR2026/motor_drivers
+ */
+#ifndef MOTOR_IF_HPP
+#define MOTOR_IF_HPP
+
+#include <type_traits>
+#include "motor_if.h"
+
+namespace motor_if
+{
+
+/**
+ * 电机特性，每种电机特化一次，未特化的类型在编译期报错
+ *
+ * 各成员与 motor_if.c 中该电机的 Motor_Ops_t 一一对应，不支持的操作为空操作；
+ * 反馈读取使用与操作表相同的驱动宏 (__X_GET_*)，驱动修改字段时两条路径保持一致
+ */
+template <typename M> struct MotorTraits;
+
+#ifdef USE_DJI
+template <> struct MotorTraits<DJI_t>
+{
+    static constexpr MotorType_t type = MOTOR_TYPE_DJI;
+
+    static float      GetAngle(const DJI_t* m) { return __DJI_GET_ANGLE(m); }
+    static float      GetVelocity(const DJI_t* m) { return __DJI_GET_VELOCITY(m); }
+    static MotorPos_t GetPos(const DJI_t* m) { return __DJI_GET_POS(m); }
+    static void       ApplyOutput(DJI_t* m, const float output) { __DJI_SET_IQ_CMD(m, output); }
+    static void       SendVelocity(DJI_t*, float) {}
+    static void       SendPosition(DJI_t*, float) {}
+    static void       ApplyCurrent(DJI_t* m, const float current) { DJI_SetCurrent(m, current); }
+    static void       ResetAngle(DJI_t* m) { DJI_ResetAngle(m); }
+};
+#endif
+
+#ifdef USE_TB6612
+template <> struct MotorTraits<TB6612_t>
+{
+    static constexpr MotorType_t type = MOTOR_TYPE_TB6612;
+
+    static float      GetAngle(const TB6612_t* m) { return __TB6612_GET_ANGLE(m); }
+    static float      GetVelocity(const TB6612_t* m) { return __TB6612_GET_VELOCITY(m); }
+    static MotorPos_t GetPos(const TB6612_t* m) { return __TB6612_GET_POS(m); }
+    static void       ApplyOutput(TB6612_t* m, const float output) { TB6612_SetSpeed(m, output); }
+    static void       SendVelocity(TB6612_t*, float) {}
+    static void       SendPosition(TB6612_t*, float) {}
+    static void       ApplyCurrent(TB6612_t* m, const float duty) { TB6612_SetSpeed(m, duty); }
+    static void       ResetAngle(TB6612_t* m) { __TB6612_RESET_ANGLE(m); }
+};
+#endif
+
+#ifdef USE_VESC
+template <> struct MotorTraits<VESC_t>
+{
+    static constexpr MotorType_t type = MOTOR_TYPE_VESC;
+
+    static float      GetAngle(const VESC_t* m) { return __VESC_GET_ANGLE(m); }
+    static float      GetVelocity(const VESC_t* m) { return __VESC_GET_VELOCITY(m); }
+    static MotorPos_t GetPos(const VESC_t* m) { return __VESC_GET_POS(m); }
+    static void       ApplyOutput(VESC_t*, float) {} // VESC 电调不应在控制时设置电流
+    static void       SendVelocity(VESC_t* m, const float velocity)
+    {
+        VESC_SendSetCmd(m, VESC_CAN_SET_RPM, velocity);
+    }
+    static void       SendPosition(VESC_t*, float) {} // VESC_CAN_SET_POS 仅是单圈位置
+    static void       ApplyCurrent(VESC_t* m, const float current)
+    {
+        VESC_SendSetCmd(m, VESC_CAN_SET_CURRENT, current);
+    }
+    static void       ResetAngle(VESC_t* m) { VESC_ResetAngle(m); }
+};
+#endif
+
+#ifdef USE_DM
+template <> struct MotorTraits<DM_t>
+{
+    static constexpr MotorType_t type = MOTOR_TYPE_DM;
+
+    static float      GetAngle(const DM_t* m) { return __DM_GET_ANGLE(m); }
+    static float      GetVelocity(const DM_t* m) { return __DM_GET_VELOCITY(m); }
+    static MotorPos_t GetPos(const DM_t* m) { return __DM_GET_POS(m); }
+    static void       ApplyOutput(DM_t*, float) {} // DM 电调不应该在控制时设置电流
+    static void       SendVelocity(DM_t* m, const float velocity)
+    {
+        DM_Vel_SendSetCmd(m, velocity);
+    }
+    static void       SendPosition(DM_t*, float) {} // DM_Pos_SendSetCmd 暂未接入
+    static void       ApplyCurrent(DM_t* m, const float torque) { DM_MIT_SendTorqueCmd(m, torque); }
+    static void       ResetAngle(DM_t*) {}
+};
+#endif
+
+/**
+ * 下发一次控制计算得到的指令
+ */
+template <typename M> inline void ApplyCmd(M* motor, const Motor_Cmd_t cmd)
+{
+    using Traits = MotorTraits<M>;
+    switch (cmd.type)
+    {
+    case MOTOR_CMD_OUTPUT:
+        Traits::ApplyOutput(motor, cmd.value);
+        break;
+    case MOTOR_CMD_VELOCITY:
+        Traits::SendVelocity(motor, cmd.value);
+        break;
+    case MOTOR_CMD_POSITION:
+        Traits::SendPosition(motor, cmd.value);
+        break;
+    default:;
+    }
+}
+
+/**
+ * 位置环控制对象
+ */
+template <typename M> class PosCtrl
+{
+public:
+    using Traits = MotorTraits<M>;
+
+    /**
+     * 初始化，电机类型由模板参数决定，配置中的 motor_type 和 motor 会被覆盖
+     * @param motor 受控电机
+     * @param config 配置
+     */
+    void Init(M* motor, Motor_PosCtrlConfig_t config)
+    {
+        config.motor_type = Traits::type;
+        config.motor      = motor;
+        Motor_PosCtrl_Init(&ctrl_, &config);
+    }
+
+    /**
+     * 控制计算，等价于 Motor_PosCtrlUpdate
+     */
+    void Update()
+    {
+        if (!ctrl_.enable)
+            return;
+
+        PROFILE_BEGIN();
+        const Motor_State_t state = {
+            Traits::GetAngle(motor()),
+            Traits::GetVelocity(motor()),
+            Traits::GetPos(motor()),
+        };
+        ApplyCmd(motor(), Motor_PosCtrl_Step(&ctrl_, &state));
+        PROFILE_END(&ctrl_.profile);
+    }
+
+    void Enable() { ctrl_.enable = true; }
+    void Disable() { ctrl_.enable = false; }
+    void SetRef(const float ref) { Motor_PosCtrl_SetRef(&ctrl_, ref); }
+    void SetRefPos(const MotorPos_t ref) { Motor_PosCtrl_SetRefPos(&ctrl_, ref); }
+    bool IsSettle() { return Motor_PosCtrl_IsSettle(&ctrl_); }
+    void SetFeedforward(const float velocity, const float acceleration, const float torque)
+    {
+        Motor_PosCtrl_SetFeedforward(&ctrl_, velocity, acceleration, torque);
+    }
+
+    float GetAngle() const { return Traits::GetAngle(motor()); }
+    float GetVelocity() const { return Traits::GetVelocity(motor()); }
+    void  ResetAngle() { Traits::ResetAngle(motor()); }
+
+    M*                     motor() const { return static_cast<M*>(ctrl_.motor); }
+    Motor_PosCtrl_t*       c() { return &ctrl_; }
+    const Motor_PosCtrl_t* c() const { return &ctrl_; }
+
+private:
+    Motor_PosCtrl_t ctrl_;
+};
+
+/**
+ * 速度环控制对象
+ */
+template <typename M> class VelCtrl
+{
+public:
+    using Traits = MotorTraits<M>;
+
+    /**
+     * 初始化，电机类型由模板参数决定，配置中的 motor_type 和 motor 会被覆盖
+     * @param motor 受控电机
+     * @param config 配置
+     */
+    void Init(M* motor, Motor_VelCtrlConfig_t config)
+    {
+        config.motor_type = Traits::type;
+        config.motor      = motor;
+        Motor_VelCtrl_Init(&ctrl_, &config);
+    }
+
+    /**
+     * 控制计算，等价于 Motor_VelCtrlUpdate
+     */
+    void Update()
+    {
+        if (!ctrl_.enable)
+            return;
+
+        PROFILE_BEGIN();
+        ApplyCmd(motor(), Motor_VelCtrl_Step(&ctrl_, Traits::GetVelocity(motor())));
+        PROFILE_END(&ctrl_.profile);
+    }
+
+    void Enable() { ctrl_.enable = true; }
+    void Disable() { ctrl_.enable = false; }
+    void SetRef(const float ref) { Motor_VelCtrl_SetRef(&ctrl_, ref); }
+
+    float GetAngle() const { return Traits::GetAngle(motor()); }
+    float GetVelocity() const { return Traits::GetVelocity(motor()); }
+    void  ResetAngle() { Traits::ResetAngle(motor()); }
+
+    M*                     motor() const { return static_cast<M*>(ctrl_.motor); }
+    Motor_VelCtrl_t*       c() { return &ctrl_; }
+    const Motor_VelCtrl_t* c() const { return &ctrl_; }
+
+private:
+    Motor_VelCtrl_t ctrl_;
+};
+
+/**
+ * 电流 (力矩) 控制对象
+ */
+template <typename M> class CurCtrl
+{
+public:
+    using Traits = MotorTraits<M>;
+
+    /**
+     * 初始化，电机类型由模板参数决定，配置中的 motor_type 和 motor 会被覆盖
+     * @param motor 受控电机
+     * @param config 配置
+     */
+    void Init(M* motor, Motor_CurCtrlConfig_t config)
+    {
+        config.motor_type = Traits::type;
+        config.motor      = motor;
+        Motor_CurCtrl_Init(&ctrl_, &config);
+    }
+
+    /**
+     * 控制计算，等价于 Motor_CurCtrlUpdate
+     */
+    void Update()
+    {
+        if (!ctrl_.enable)
+            return;
+
+        PROFILE_BEGIN();
+        Traits::ApplyCurrent(motor(), Motor_CurCtrl_Step(&ctrl_));
+        PROFILE_END(&ctrl_.profile);
+    }
+
+    void Enable() { ctrl_.enable = true; }
+    void Disable() { ctrl_.enable = false; }
+    void SetCurrent(const float current) { Motor_CurCtrl_SetCurrent(&ctrl_, current); }
+    void SetTorque(const float torque) { Motor_CurCtrl_SetTorque(&ctrl_, torque); }
+
+    M*                     motor() const { return static_cast<M*>(ctrl_.motor); }
+    Motor_CurCtrl_t*       c() { return &ctrl_; }
+    const Motor_CurCtrl_t* c() const { return &ctrl_; }
+
+private:
+    Motor_CurCtrl_t ctrl_;
+};
+
+/**
+ * 由句柄取得指定类型的电机
+ * @return 电机，类型不符或句柄无效时返回 nullptr
+ */
+template <typename M> inline M* FromHandle(const Motor_Handle_t handle)
+{
+    return static_cast<M*>(Motor_Registry_GetMotorAs(handle, MotorTraits<M>::type));
+}
+
+/**
+ * 由 C 指针取得包装对象，仅当该 C 对象本身就是包装对象的成员时有效
+ */
+template <typename Wrapper, typename C> inline Wrapper* FromC(C* hctrl)
+{
+    static_assert(sizeof(Wrapper) == sizeof(C), "wrapper must have the same layout as C struct");
+    return reinterpret_cast<Wrapper*>(hctrl);
+}
+
+#ifdef USE_DJI
+static_assert(std::is_standard_layout<PosCtrl<DJI_t>>::value &&
+                      sizeof(PosCtrl<DJI_t>) == sizeof(Motor_PosCtrl_t),
+              "PosCtrl must keep the layout of Motor_PosCtrl_t");
+static_assert(std::is_standard_layout<VelCtrl<DJI_t>>::value &&
+                      sizeof(VelCtrl<DJI_t>) == sizeof(Motor_VelCtrl_t),
+              "VelCtrl must keep the layout of Motor_VelCtrl_t");
+static_assert(std::is_standard_layout<CurCtrl<DJI_t>>::value &&
+                      sizeof(CurCtrl<DJI_t>) == sizeof(Motor_CurCtrl_t),
+              "CurCtrl must keep the layout of Motor_CurCtrl_t");
+#endif
+
+} // namespace motor_if
+
+#endif // MOTOR_IF_HPP